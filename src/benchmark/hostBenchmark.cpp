@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstdio>
+
+#include "codec/codecBenchmark.h"
+
+
+/*
+ * Codec kernel throughput on a host, e.g. the Linux gateway.
+ * Ticks are nanoseconds here (cycles on target, see readme.)
+ */
+
+namespace {
+
+const size_t DataLength = 4096;
+const unsigned int RepeatCount = 256;
+
+// configureMediumCRC()
+const RadioCRCParameters MediumCRC = { 2, 0xFFFF, 0x11021, false, false };
+
+// Large tables: static, not on the stack
+RadioCRCEngine<8> crcEngine(MediumCRC);
+HammingFEC fecCodec;
+
+uint8_t data[DataLength];
+uint8_t encoded[DataLength / HammingFEC::BlockDataLength * HammingFEC::BlockEncodedLength];
+uint8_t decoded[DataLength];
+
+
+uint32_t nanoseconds() {
+	return (uint32_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void fillData() {
+	uint32_t state = 1;
+	for (size_t i = 0; i < DataLength; i++) {
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		data[i] = (uint8_t) state;
+	}
+}
+
+void report(const KernelThroughput& result) {
+	const float ticksPerByte = result.ticksPerByte();
+	printf("%-16s %8.2f ns/byte %10.1f MB/s\n",
+			result.kernel, ticksPerByte, ticksPerByte > 0 ? 1000.0f / ticksPerByte : 0);
+}
+
+}  // namespace
+
+
+
+int main() {
+	fillData();
+
+	KernelThroughput crcResults[CodecBenchmark::CRCKernelCount];
+	CodecBenchmark::crc(crcEngine, nanoseconds, data, DataLength, RepeatCount, crcResults);
+	for (const KernelThroughput& result : crcResults) {
+		report(result);
+	}
+
+	KernelThroughput fecResults[CodecBenchmark::FECKernelCount];
+	CodecBenchmark::fec(fecCodec, nanoseconds, data, DataLength, RepeatCount, encoded, decoded, fecResults);
+	for (const KernelThroughput& result : fecResults) {
+		report(result);
+	}
+	return 0;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>	// size_t
+
+#include "radioCRC.h"
+#include "hammingFEC.h"
+
+
+/*
+ * Ticks of a free running 32-bit counter, supplied by the caller:
+ * on target MCU::cycleCount() (CPU cycles, NRF52_SERIES), on a host e.g. nanoseconds (see src/benchmark.)
+ */
+typedef uint32_t (*TickCounter)();
+
+
+/*
+ * One kernel's measurement.
+ */
+struct KernelThroughput {
+	const char* kernel;
+	uint32_t byteCount;
+	uint32_t ticks;
+
+	float ticksPerByte() const { return byteCount != 0 ? (float) ticks / byteCount : 0; }
+};
+
+
+/*
+ * Throughput of the codec kernels, in ticks per byte.
+ *
+ * Each kernel runs over the caller's data repeatCount times, between two reads of the counter.
+ * The counter wraps: keep count * repeatCount small enough that one kernel takes under 2^32 ticks.
+ * Engines are the caller's (tables are large), so their construction is not measured.
+ *
+ * Portable (no Nordic API's): the same routines run on target and host.
+ */
+class CodecBenchmark {
+public:
+	static const unsigned int CRCKernelCount = 3;
+	static const unsigned int FECKernelCount = 2;
+
+	/*
+	 * results: bitwise, table, sliced (sliced is table when SliceCount < 4.)
+	 */
+	template <unsigned int SliceCount>
+	static void crc(
+			const RadioCRCEngine<SliceCount>& engine,
+			TickCounter counter,
+			const uint8_t* data,
+			size_t count,
+			unsigned int repeatCount,
+			KernelThroughput results[CRCKernelCount])
+	{
+		// Keeps the compiler from discarding the CRC's
+		volatile uint32_t sink = 0;
+		uint32_t start;
+
+		start = counter();
+		for (unsigned int i = 0; i < repeatCount; i++) {
+			sink = engine.updateBitwise(engine.start(), data, count);
+		}
+		results[0] = KernelThroughput{ "crc bitwise", (uint32_t) (count * repeatCount), counter() - start };
+
+		start = counter();
+		for (unsigned int i = 0; i < repeatCount; i++) {
+			sink = engine.updateTable(engine.start(), data, count);
+		}
+		results[1] = KernelThroughput{ "crc table", (uint32_t) (count * repeatCount), counter() - start };
+
+		start = counter();
+		for (unsigned int i = 0; i < repeatCount; i++) {
+			sink = engine.updateSliced(engine.start(), data, count);
+		}
+		results[2] = KernelThroughput{ "crc sliced", (uint32_t) (count * repeatCount), counter() - start };
+
+		(void) sink;
+	}
+
+	/*
+	 * results: encode, decode (of the error free encoding.)
+	 * Both per data byte: the encoded bytes are twice as many.
+	 * encoded has room for HammingFEC::encodedLength(count) bytes, decoded for count bytes.
+	 */
+	static void fec(
+			const HammingFEC& codec,
+			TickCounter counter,
+			const uint8_t* data,
+			size_t count,
+			unsigned int repeatCount,
+			uint8_t* encoded,
+			uint8_t* decoded,
+			KernelThroughput results[FECKernelCount])
+	{
+		volatile uint32_t sink = 0;
+		unsigned int correctedCount;
+		uint32_t start;
+
+		start = counter();
+		for (unsigned int i = 0; i < repeatCount; i++) {
+			codec.encode(data, count, encoded);
+			sink = encoded[0];
+		}
+		results[0] = KernelThroughput{ "fec encode", (uint32_t) (count * repeatCount), counter() - start };
+
+		start = counter();
+		for (unsigned int i = 0; i < repeatCount; i++) {
+			sink = codec.decode(encoded, count, decoded, correctedCount);
+		}
+		results[1] = KernelThroughput{ "fec decode", (uint32_t) (count * repeatCount), counter() - start };
+
+		(void) sink;
+	}
+};
@@ -0,0 +1,79 @@
+#include <cassert>
+
+#include "crcAnalysis.h"
+
+
+namespace {
+
+/*
+ * xorshift32: small, fast, good enough for choosing error patterns.
+ * State must not be zero.
+ */
+uint32_t nextRandom(uint32_t& state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+}  // namespace
+
+
+
+uint32_t CRCAnalysis::undetectedErrorCount(
+		const RadioCRCEngine<1>& engine,
+		unsigned int payloadLength,
+		unsigned int errorBitCount,
+		uint32_t trialCount,
+		uint32_t seed)
+{
+	const unsigned int crcLength = engine.configuration().length;
+	const unsigned int packetLength = payloadLength + crcLength;
+	const unsigned int packetBits = 8 * packetLength;
+
+	assert(payloadLength <= MaxPayloadLength);
+	assert(errorBitCount >= 1 and errorBitCount <= packetBits);
+
+	// payload followed by on-air CRC
+	uint8_t packet[MaxPayloadLength + 3];
+	uint32_t state = (seed != 0) ? seed : 1;
+	uint32_t undetected = 0;
+
+	for (uint32_t trial = 0; trial < trialCount; trial++) {
+		for (unsigned int i = 0; i < payloadLength; i++) {
+			packet[i] = (uint8_t) nextRandom(state);
+		}
+		uint32_t crc = engine.finish(engine.updateTable(engine.start(), packet, payloadLength));
+		engine.toOnAirBytes(crc, packet + payloadLength);
+
+		// Flip distinct bits: retry a bit already flipped by this trial
+		unsigned int flipped = 0;
+		uint8_t errorMask[MaxPayloadLength + 3] = { 0 };
+		while (flipped < errorBitCount) {
+			unsigned int bit = nextRandom(state) % packetBits;
+			uint8_t mask = (uint8_t) (1 << (bit % 8));
+			if (!(errorMask[bit / 8] & mask)) {
+				errorMask[bit / 8] |= mask;
+				packet[bit / 8] ^= mask;
+				flipped++;
+			}
+		}
+
+		uint32_t corruptedCRC = engine.finish(engine.updateTable(engine.start(), packet, payloadLength));
+		if (corruptedCRC == engine.fromOnAirBytes(packet + payloadLength))
+			undetected++;
+	}
+	return undetected;
+}
+
+
+double CRCAnalysis::undetectedErrorRate(
+		const RadioCRCEngine<1>& engine,
+		unsigned int payloadLength,
+		unsigned int errorBitCount,
+		uint32_t trialCount,
+		uint32_t seed)
+{
+	if (trialCount == 0)  return 0;
+	return (double) undetectedErrorCount(engine, payloadLength, errorBitCount, trialCount, seed) / trialCount;
+}
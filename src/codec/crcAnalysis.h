@@ -0,0 +1,41 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "radioCRC.h"
+
+
+/*
+ * Measures how well a candidate CRC polynomial detects errors at a given payload length.
+ *
+ * Monte Carlo: random payload, flip errorBitCount distinct random bits of payload+CRC,
+ * count how often the corrupted packet still passes the CRC.
+ *
+ * Intended for a host (comparing polynomials off-target), but portable.
+ * Deterministic for a given seed.
+ */
+class CRCAnalysis {
+public:
+	/*
+	 * Upper limit on payloadLength.
+	 */
+	static const unsigned int MaxPayloadLength = 255;
+
+	/*
+	 * Returns count of undetected errors out of trialCount.
+	 * errorBitCount must be at least one and at most bits in payload+CRC.
+	 */
+	static uint32_t undetectedErrorCount(
+			const RadioCRCEngine<1>& engine,
+			unsigned int payloadLength,
+			unsigned int errorBitCount,
+			uint32_t trialCount,
+			uint32_t seed);
+
+	static double undetectedErrorRate(
+			const RadioCRCEngine<1>& engine,
+			unsigned int payloadLength,
+			unsigned int errorBitCount,
+			uint32_t trialCount,
+			uint32_t seed);
+};
@@ -0,0 +1,147 @@
+#include "hammingFEC.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Codeword bits: 0..3 data, 4..6 Hamming parity, 7 overall parity.
+ * Minimum distance is 4, so the decode table is built by search:
+ * a received byte is a codeword, or distance one from exactly one codeword, or else uncorrectable.
+ *
+ * Transpose: Hacker's Delight transpose8, rows are bytes (MSB is column zero.)
+ */
+
+namespace {
+
+const uint8_t DecodeCorrected = 0x10;
+const uint8_t DecodeUncorrectable = 0x20;
+
+unsigned int bit(uint8_t value, unsigned int index) { return (value >> index) & 1; }
+
+unsigned int parity(uint8_t value) {
+	value ^= value >> 4;
+	value ^= value >> 2;
+	value ^= value >> 1;
+	return value & 1;
+}
+
+unsigned int distance(uint8_t a, uint8_t b) {
+	unsigned int result = 0;
+	for (uint8_t diff = a ^ b; diff != 0; diff &= diff - 1) {
+		result++;
+	}
+	return result;
+}
+
+}  // namespace
+
+
+
+uint8_t HammingFEC::encodeNibbleBitwise(uint8_t nibble) {
+	uint8_t word = nibble & 0x0F;
+	word |= (uint8_t) ((bit(word, 0) ^ bit(word, 1) ^ bit(word, 3)) << 4);
+	word |= (uint8_t) ((bit(word, 0) ^ bit(word, 2) ^ bit(word, 3)) << 5);
+	word |= (uint8_t) ((bit(word, 1) ^ bit(word, 2) ^ bit(word, 3)) << 6);
+	word |= (uint8_t) (parity(word) << 7);
+	return word;
+}
+
+
+HammingFEC::HammingFEC() {
+	for (unsigned int nibble = 0; nibble < 16; nibble++) {
+		encodeTable[nibble] = encodeNibbleBitwise((uint8_t) nibble);
+	}
+
+	for (unsigned int received = 0; received < 256; received++) {
+		// Uncorrectable: pass the data bits through
+		uint8_t entry = (uint8_t) (DecodeUncorrectable | (received & 0x0F));
+		for (unsigned int nibble = 0; nibble < 16; nibble++) {
+			unsigned int d = distance((uint8_t) received, encodeTable[nibble]);
+			if (d == 0) {
+				entry = (uint8_t) nibble;
+				break;
+			}
+			if (d == 1) {
+				entry = (uint8_t) (DecodeCorrected | nibble);
+				break;
+			}
+		}
+		decodeTable[received] = entry;
+	}
+}
+
+
+
+void HammingFEC::transposeBlock(uint8_t* block) {
+	uint32_t x = ((uint32_t) block[0] << 24) | ((uint32_t) block[1] << 16) | ((uint32_t) block[2] << 8) | block[3];
+	uint32_t y = ((uint32_t) block[4] << 24) | ((uint32_t) block[5] << 16) | ((uint32_t) block[6] << 8) | block[7];
+	uint32_t t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC;  x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC;  y = y ^ t ^ (t << 14);
+
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	block[0] = (uint8_t) (x >> 24);  block[1] = (uint8_t) (x >> 16);  block[2] = (uint8_t) (x >> 8);  block[3] = (uint8_t) x;
+	block[4] = (uint8_t) (y >> 24);  block[5] = (uint8_t) (y >> 16);  block[6] = (uint8_t) (y >> 8);  block[7] = (uint8_t) y;
+}
+
+
+void HammingFEC::encodeBlock(const uint8_t* data, uint8_t* encoded) const {
+	for (unsigned int i = 0; i < BlockDataLength; i++) {
+		encoded[2 * i] = encodeTable[data[i] & 0x0F];
+		encoded[2 * i + 1] = encodeTable[data[i] >> 4];
+	}
+	transposeBlock(encoded);
+}
+
+
+
+void HammingFEC::encode(const uint8_t* data, size_t dataLength, uint8_t* encoded) const {
+	while (dataLength >= BlockDataLength) {
+		encodeBlock(data, encoded);
+		data += BlockDataLength;
+		encoded += BlockEncodedLength;
+		dataLength -= BlockDataLength;
+	}
+	if (dataLength > 0) {
+		uint8_t padded[BlockDataLength] = { 0 };
+		for (size_t i = 0; i < dataLength; i++) {
+			padded[i] = data[i];
+		}
+		encodeBlock(padded, encoded);
+	}
+}
+
+
+bool HammingFEC::decode(const uint8_t* encoded, size_t dataLength, uint8_t* data, unsigned int& correctedCount) const {
+	bool isDecoded = true;
+	correctedCount = 0;
+
+	while (dataLength > 0) {
+		uint8_t words[BlockEncodedLength];
+		for (unsigned int i = 0; i < BlockEncodedLength; i++) {
+			words[i] = encoded[i];
+		}
+		transposeBlock(words);
+
+		const size_t count = dataLength < BlockDataLength ? dataLength : BlockDataLength;
+		for (size_t i = 0; i < count; i++) {
+			uint8_t low = decodeTable[words[2 * i]];
+			uint8_t high = decodeTable[words[2 * i + 1]];
+			data[i] = (uint8_t) ((low & 0x0F) | (high << 4));
+			correctedCount += ((low & DecodeCorrected) != 0) + ((high & DecodeCorrected) != 0);
+			if ((low | high) & DecodeUncorrectable) {
+				isDecoded = false;
+			}
+		}
+		encoded += BlockEncodedLength;
+		data += count;
+		dataLength -= count;
+	}
+	return isDecoded;
+}
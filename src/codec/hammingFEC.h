@@ -0,0 +1,76 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>	// size_t
+
+
+/*
+ * Forward error correction for radio payloads: extended Hamming(8,4) codewords, interleaved.
+ *
+ * The radio only detects errors (CRC.)  Encode the app's payload before transmitting,
+ * decode after receiving: a packet with few bit errors is then corrected instead of retransmitted.
+ * Still use the radio CRC: it covers the encoded bytes, so expect CRC failures on corrected packets
+ * (accept packets whose CRC failed, and rely on decode() instead, or use an app-level CRC over the data.)
+ *
+ * Code: each data nibble becomes one byte, Hamming(7,4) plus an overall parity bit.
+ * Corrects one bit error and detects two per codeword.  Rate 1/2.
+ *
+ * Interleaving: a block is 4 data bytes, 8 codewords, 8 encoded bytes.
+ * The block is an 8x8 bit matrix, transposed: each encoded byte holds one bit of every codeword.
+ * So any burst of up to 8 consecutive on-air bits (either PCNF1.ENDIAN) is at most one bit per codeword,
+ * and is corrected.
+ * The transpose is its own inverse, and is done a 32-bit word at a time.
+ *
+ * Data is padded with zero to a whole block: encodedLength(dataLength) is a multiple of 8.
+ * The receiver must know dataLength (e.g. from an app header, or fixed.)
+ * Max radio payload 255 bytes: at most 124 data bytes in 248 encoded bytes.
+ *
+ * Kernels are table driven: a 16 entry encode table, a 256 entry decode table.
+ * Tables are members, so the user chooses where they live (272 bytes.)
+ */
+class HammingFEC {
+public:
+	static const unsigned int BlockDataLength = 4;
+	static const unsigned int BlockEncodedLength = 8;
+
+private:
+	uint8_t encodeTable[16];
+	/*
+	 * Indexed by received codeword.  Low nibble: decoded nibble.
+	 * High bits: DecodeCorrected, DecodeUncorrectable.
+	 */
+	uint8_t decodeTable[256];
+
+	void encodeBlock(const uint8_t* data, uint8_t* encoded) const;
+
+public:
+	HammingFEC();
+
+	static size_t encodedLength(size_t dataLength) {
+		return ((dataLength + BlockDataLength - 1) / BlockDataLength) * BlockEncodedLength;
+	}
+
+	/*
+	 * encoded must have room for encodedLength(dataLength) bytes.
+	 */
+	void encode(const uint8_t* data, size_t dataLength, uint8_t* encoded) const;
+
+	/*
+	 * encoded is encodedLength(dataLength) bytes.  Writes dataLength bytes to data.
+	 * Returns false if some codeword had an uncorrectable (two bit) error: data is then not reliable.
+	 * correctedCount is count of codewords corrected.
+	 * Codewords of padding are not checked.
+	 */
+	bool decode(const uint8_t* encoded, size_t dataLength, uint8_t* data, unsigned int& correctedCount) const;
+
+
+	/*
+	 * Reference: one codeword, computed from the parity equations (no table.)
+	 */
+	static uint8_t encodeNibbleBitwise(uint8_t nibble);
+
+	/*
+	 * Interleave or deinterleave one block in place.
+	 */
+	static void transposeBlock(uint8_t* block);
+};
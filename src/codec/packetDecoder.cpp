@@ -0,0 +1,214 @@
+#include <cassert>
+
+#include "packetDecoder.h"
+
+
+void PacketDecoder::onAirAddress(uint32_t base, uint8_t prefix, uint8_t addressLength, uint8_t* address) {
+	assert(addressLength >= 2 and addressLength <= 5);
+
+	// Base is truncated from LSByte: only the (addressLength - 1) MSBytes are used, LSByte of those first
+	unsigned int baseLength = addressLength - 1;
+	for (unsigned int i = 0; i < baseLength; i++) {
+		address[i] = (uint8_t) (base >> (8 * (4 - baseLength + i)));
+	}
+	// Prefix last
+	address[baseLength] = prefix;
+}
+
+
+PacketDecoder::PacketDecoder(const OnAirPacketFormat& aFormat, const RadioCRCEngine<1>& aCRCEngine, DecodedPacketCallback aCallback) :
+	format(aFormat),
+	crcEngine(aCRCEngine),
+	callback(aCallback),
+	keystream(aFormat.whiteningIV),
+	addressBits(8 * aFormat.addressLength)
+{
+	assert(format.addressLength >= 2 and format.addressLength <= 5);
+	assert(format.s0Bytes <= 1);
+	assert(format.lengthBits <= 8);
+	assert(format.s1Bits <= 16);
+
+	// Address is always LSB first on-air: pattern is the address as a little endian integer
+	addressPattern = 0;
+	for (unsigned int i = 0; i < format.addressLength; i++) {
+		addressPattern |= (uint64_t) format.address[i] << (8 * i);
+	}
+	addressMask = ((uint64_t) 1 << addressBits) - 1;
+
+	packets = 0;
+	crcErrors = 0;
+	lengthErrors = 0;
+	reset();
+}
+
+
+void PacketDecoder::reset() {
+	streamBitCount = 0;
+	startSearching();
+}
+
+void PacketDecoder::startSearching() {
+	window = 0;
+	searchBitCount = 0;
+	field = Field::Searching;
+}
+
+
+void PacketDecoder::decode(const uint8_t* bytes, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		uint8_t byte = bytes[i];
+		for (unsigned int bit = 0; bit < 8; bit++) {
+			decodeBit((byte >> bit) & 1);
+		}
+	}
+}
+
+
+void PacketDecoder::decodeBit(unsigned int bit) {
+	streamBitCount++;
+
+	if (field == Field::Searching) {
+		// Newest bit enters at top, so oldest (first on-air) is LSB
+		window = (window >> 1) | ((uint64_t) bit << (addressBits - 1));
+		searchBitCount++;
+		if (searchBitCount >= addressBits and (window & addressMask) == addressPattern) {
+			startPacket();
+		}
+	}
+	else {
+		if (format.isWhitened)  bit ^= keystream.bitAt(whiteningBitIndex++);
+		if (field != Field::CRC)  crc = crcEngine.updateBit(crc, bit);
+		collectBit(bit);
+	}
+}
+
+
+void PacketDecoder::startPacket() {
+	packet.addressEndBit = streamBitCount - 1;
+	packet.s0 = 0;
+	packet.length = format.staticLength;
+	packet.s1 = 0;
+	whiteningBitIndex = 0;
+
+	crc = crcEngine.start();
+	if (!crcEngine.configuration().isSkipAddress) {
+		for (unsigned int i = 0; i < addressBits; i++) {
+			crc = crcEngine.updateBit(crc, (unsigned int) (addressPattern >> i) & 1);
+		}
+	}
+
+	if (format.s0Bytes > 0)
+		startField(Field::S0, 8 * format.s0Bytes);
+	else if (format.lengthBits > 0)
+		startField(Field::Length, format.lengthBits);
+	else if (format.s1Bits > 0)
+		startField(Field::S1, format.s1Bits);
+	else
+		startPayloadOrCRC();
+}
+
+
+void PacketDecoder::startField(Field nextField, unsigned int bits) {
+	field = nextField;
+	fieldBits = bits;
+	fieldValue = 0;
+	fieldBitIndex = 0;
+}
+
+
+/*
+ * Little endian: field is LSB first.  Big endian: MSB first.
+ * CRC is always MSB first.
+ * Payload is collected a byte at a time.
+ */
+void PacketDecoder::collectBit(unsigned int bit) {
+	bool isMSBFirst = (field == Field::CRC) or format.isBigEndian;
+	if (isMSBFirst) {
+		fieldValue = (fieldValue << 1) | bit;
+	}
+	else {
+		unsigned int shift = (field == Field::Payload) ? fieldBitIndex % 8 : fieldBitIndex;
+		fieldValue |= (uint32_t) bit << shift;
+	}
+
+	fieldBitIndex++;
+	if (field == Field::Payload and fieldBitIndex % 8 == 0) {
+		payload[fieldBitIndex / 8 - 1] = (uint8_t) fieldValue;
+		fieldValue = 0;
+	}
+	if (fieldBitIndex == fieldBits) {
+		endField();
+	}
+}
+
+
+void PacketDecoder::endField() {
+	switch(field) {
+	case Field::S0:
+		packet.s0 = fieldValue;
+		if (format.lengthBits > 0)
+			startField(Field::Length, format.lengthBits);
+		else if (format.s1Bits > 0)
+			startField(Field::S1, format.s1Bits);
+		else
+			startPayloadOrCRC();
+		break;
+
+	case Field::Length:
+		packet.length = fieldValue;
+		if (packet.length > format.maxLength) {
+			lengthErrors++;
+			startSearching();
+			return;
+		}
+		if (format.s1Bits > 0)
+			startField(Field::S1, format.s1Bits);
+		else
+			startPayloadOrCRC();
+		break;
+
+	case Field::S1:
+		packet.s1 = fieldValue;
+		startPayloadOrCRC();
+		break;
+
+	case Field::Payload:
+		startPayloadOrCRC();
+		break;
+
+	case Field::CRC:
+		endPacket();
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+void PacketDecoder::startPayloadOrCRC() {
+	if (field != Field::Payload and packet.length > 0) {
+		startField(Field::Payload, 8 * packet.length);
+	}
+	else if (crcEngine.configuration().length > 0) {
+		startField(Field::CRC, 8 * crcEngine.configuration().length);
+	}
+	else {
+		field = Field::CRC;
+		fieldValue = 0;
+		endPacket();
+	}
+}
+
+
+void PacketDecoder::endPacket() {
+	packet.payload = payload;
+	packet.isCRCValid = (crcEngine.configuration().length == 0)
+			or (crcEngine.finish(crc) == fieldValue);
+
+	packets++;
+	if (!packet.isCRCValid)  crcErrors++;
+	if (callback != nullptr)  callback(packet);
+
+	startSearching();
+}
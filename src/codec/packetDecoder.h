@@ -0,0 +1,128 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>	// size_t
+
+#include "radioCRC.h"
+#include "whitening.h"
+
+
+/*
+ * On-air packet format, as configured in the radio device (PCNF0, PCNF1, address registers.)
+ *
+ * Address is in on-air byte order: LSByte of truncated base first, prefix last.
+ * See onAirAddress().
+ * Static length (LENGTH not transmitted) when lengthBits is zero.
+ */
+struct OnAirPacketFormat {
+	uint8_t address[5];
+	uint8_t addressLength;	// bytes, 2..5 (BALEN + 1)
+	uint8_t s0Bytes;	// S0LEN
+	uint8_t lengthBits;	// LFLEN
+	uint8_t s1Bits;		// S1LEN
+	uint8_t staticLength;	// STATLEN
+	uint8_t maxLength;	// MAXLEN
+	bool isWhitened;
+	uint8_t whiteningIV;	// DATAWHITEIV
+	bool isBigEndian;	// PCNF1.ENDIAN
+};
+
+
+/*
+ * Result of decoding one packet.
+ * payload is valid only during the callback.
+ */
+struct DecodedPacket {
+	uint32_t s0;
+	uint32_t length;
+	uint32_t s1;
+	const uint8_t* payload;
+	bool isCRCValid;
+	uint64_t addressEndBit;	// bit offset in the stream of last bit of address
+};
+
+typedef void (*DecodedPacketCallback)(const DecodedPacket&);
+
+
+
+/*
+ * Streaming decoder: raw on-air captures to payloads.
+ *
+ * Input is demodulated bits, eight per byte, first in time in LSB, arbitrary bit alignment.
+ * Input may be split across calls to decode() at any point.
+ *
+ * Searches for the address (exact match, bit by bit), then dewhitens (precomputed keystream),
+ * extracts S0/LENGTH/S1/payload, checks CRC.
+ * Calls callback for every packet (valid CRC or not.)
+ *
+ * Cost is a few operations per bit, i.e. keeps up with multi-megabit traces on one core.
+ * No heap: payload buffer is a member.
+ */
+class PacketDecoder {
+public:
+	/*
+	 * Build on-air address from register values BASEn, PREFIXn.AP, and address length (BALEN + 1.)
+	 */
+	static void onAirAddress(uint32_t base, uint8_t prefix, uint8_t addressLength, uint8_t* address);
+
+	PacketDecoder(const OnAirPacketFormat& format, const RadioCRCEngine<1>& crcEngine, DecodedPacketCallback callback);
+
+	void decode(const uint8_t* bytes, size_t count);
+
+	/*
+	 * Forget any partial packet, e.g. between unrelated captures.
+	 */
+	void reset();
+
+	uint32_t packetCount() const { return packets; }
+	uint32_t crcErrorCount() const { return crcErrors; }
+	// LENGTH greater than MAXLEN, packet abandoned
+	uint32_t lengthErrorCount() const { return lengthErrors; }
+
+private:
+	enum class Field {
+		Searching,
+		S0,
+		Length,
+		S1,
+		Payload,
+		CRC
+	};
+
+	const OnAirPacketFormat format;
+	const RadioCRCEngine<1>& crcEngine;
+	const DecodedPacketCallback callback;
+	const WhiteningKeystream keystream;
+
+	const unsigned int addressBits;
+	uint64_t addressPattern;
+	uint64_t addressMask;
+
+	// Search state
+	uint64_t window;
+	unsigned int searchBitCount;	// bits in window
+	uint64_t streamBitCount;	// bits since reset
+
+	// Packet state
+	Field field;
+	unsigned int fieldBits;	// bits still to collect in field
+	uint32_t fieldValue;
+	unsigned int fieldBitIndex;	// bits collected in field
+	uint32_t whiteningBitIndex;
+	uint32_t crc;
+	DecodedPacket packet;
+	uint8_t payload[256];
+
+	uint32_t packets;
+	uint32_t crcErrors;
+	uint32_t lengthErrors;
+
+	void startSearching();
+	void decodeBit(unsigned int bit);
+	void startPacket();
+	void startField(Field nextField, unsigned int bits);
+	void collectBit(unsigned int bit);
+	void endField();
+	void startPayloadOrCRC();
+	void endPacket();
+};
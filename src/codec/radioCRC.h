@@ -0,0 +1,172 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>	// size_t
+
+
+/*
+ * Software CRC matching the radio device CRC.
+ *
+ * Parameters are the same as RadioDevice CRC configuration (registers CRCCNF, CRCINIT, CRCPOLY, PCNF1.ENDIAN.)
+ * E.G. configureShortCRC() is { 1, 0xFF, 0x12F, false, false }
+ * configureMediumCRC() is { 2, 0xFFFF, 0x11021, false, false }
+ *
+ * The device computes CRC over bits in on-air order.
+ * With little endian (the reset default) each byte goes on-air LSB first, so input bits are reflected.
+ * The CRC itself goes on-air MSB first.
+ */
+struct RadioCRCParameters {
+	uint8_t length;		// bytes 1..3 (CRCCNF.LEN)
+	uint32_t init;		// CRCINIT
+	uint32_t poly;		// CRCPOLY, as in register (x^length term may be present, is ignored)
+	bool isSkipAddress;	// CRCCNF.SKIPADDR
+	bool isBigEndian;	// PCNF1.ENDIAN
+};
+
+
+
+/*
+ * Kernels:
+ * - bitwise: no tables, slow, the reference
+ * - table: one 256 entry table, a byte per step
+ * - sliced: SliceCount tables, SliceCount bytes per step (slice-by-N), SliceCount >= 4
+ *
+ * SliceCount 1 has only the table kernel (for target, 1kB of tables.)
+ * sliced() with SliceCount < 4 is the table kernel.
+ *
+ * Implementation: register is kept left aligned in 32 bits, so one kernel serves lengths 1..3.
+ *
+ * Streaming use: crc = start(); crc = update...(crc, ...); ...; value = finish(crc)
+ */
+template <unsigned int SliceCount>
+class RadioCRCEngine {
+	static_assert(SliceCount >= 1, "SliceCount at least one");
+
+	const RadioCRCParameters parameters;
+	const unsigned int alignShift;
+	const uint32_t alignedPoly;
+	uint8_t inputMap[256];	// bit reversal, or identity if big endian
+	uint32_t tables[SliceCount][256];
+
+
+	static uint8_t reverseBits(uint8_t value) {
+		value = (uint8_t) (((value & 0xF0) >> 4) | ((value & 0x0F) << 4));
+		value = (uint8_t) (((value & 0xCC) >> 2) | ((value & 0x33) << 2));
+		value = (uint8_t) (((value & 0xAA) >> 1) | ((value & 0x55) << 1));
+		return value;
+	}
+
+	uint32_t stepByteBitwise(uint32_t crc, uint8_t onAirByte) const {
+		crc ^= (uint32_t) onAirByte << 24;
+		for (unsigned int bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x80000000UL) ? (crc << 1) ^ alignedPoly : (crc << 1);
+		}
+		return crc;
+	}
+
+	void initTables() {
+		for (unsigned int i = 0; i < 256; i++) {
+			inputMap[i] = parameters.isBigEndian ? (uint8_t) i : reverseBits((uint8_t) i);
+			tables[0][i] = stepByteBitwise(0, (uint8_t) i);
+		}
+		for (unsigned int slice = 1; slice < SliceCount; slice++) {
+			for (unsigned int i = 0; i < 256; i++) {
+				uint32_t previous = tables[slice - 1][i];
+				tables[slice][i] = (previous << 8) ^ tables[0][previous >> 24];
+			}
+		}
+	}
+
+public:
+	RadioCRCEngine(const RadioCRCParameters aParameters) :
+		parameters(aParameters),
+		alignShift(32 - 8 * aParameters.length),
+		alignedPoly((aParameters.poly << (32 - 8 * aParameters.length)))
+	{
+		initTables();
+	}
+
+	const RadioCRCParameters& configuration() const { return parameters; }
+
+	uint32_t start() const { return parameters.init << alignShift; }
+	uint32_t finish(uint32_t crc) const { return crc >> alignShift; }
+
+
+	/*
+	 * One bit, in on-air order.  For fields not a multiple of 8 bits (see PacketDecoder.)
+	 */
+	uint32_t updateBit(uint32_t crc, unsigned int bit) const {
+		crc ^= (uint32_t) bit << 31;
+		return (crc & 0x80000000UL) ? (crc << 1) ^ alignedPoly : (crc << 1);
+	}
+
+	uint32_t updateBitwise(uint32_t crc, const uint8_t* data, size_t count) const {
+		for (size_t i = 0; i < count; i++) {
+			crc = stepByteBitwise(crc, inputMap[data[i]]);
+		}
+		return crc;
+	}
+
+	uint32_t updateTable(uint32_t crc, const uint8_t* data, size_t count) const {
+		for (size_t i = 0; i < count; i++) {
+			crc = (crc << 8) ^ tables[0][(crc >> 24) ^ inputMap[data[i]]];
+		}
+		return crc;
+	}
+
+	uint32_t updateSliced(uint32_t crc, const uint8_t* data, size_t count) const {
+		if (SliceCount >= 4) {
+			while (count >= SliceCount) {
+				uint32_t word = crc ^ (
+						  ((uint32_t) inputMap[data[0]] << 24)
+						| ((uint32_t) inputMap[data[1]] << 16)
+						| ((uint32_t) inputMap[data[2]] << 8)
+						| inputMap[data[3]]);
+				uint32_t result = tables[SliceCount - 1][word >> 24]
+						^ tables[SliceCount - 2][(word >> 16) & 0xFF]
+						^ tables[SliceCount - 3][(word >> 8) & 0xFF]
+						^ tables[SliceCount - 4][word & 0xFF];
+				for (unsigned int k = 4; k < SliceCount; k++) {
+					result ^= tables[SliceCount - 1 - k][inputMap[data[k]]];
+				}
+				crc = result;
+				data += SliceCount;
+				count -= SliceCount;
+			}
+		}
+		return updateTable(crc, data, count);
+	}
+
+
+	/*
+	 * CRC of a whole packet, as the device computes it.
+	 * Address in on-air byte order (LSByte of truncated base first, prefix last.)
+	 * Data is S0, LENGTH, S1, payload in on-air byte order (i.e. as in RAM.)
+	 */
+	uint32_t computePacket(const uint8_t* address, size_t addressLength, const uint8_t* data, size_t count) const {
+		uint32_t crc = start();
+		if (!parameters.isSkipAddress)  crc = updateSliced(crc, address, addressLength);
+		crc = updateSliced(crc, data, count);
+		return finish(crc);
+	}
+
+	/*
+	 * CRC as received on-air (MSB first.)
+	 */
+	uint32_t fromOnAirBytes(const uint8_t* crcBytes) const {
+		uint32_t value = 0;
+		for (unsigned int i = 0; i < parameters.length; i++) {
+			value = (value << 8) | crcBytes[i];
+		}
+		return value;
+	}
+	void toOnAirBytes(uint32_t value, uint8_t* crcBytes) const {
+		for (unsigned int i = 0; i < parameters.length; i++) {
+			crcBytes[i] = (uint8_t) (value >> (8 * (parameters.length - 1 - i)));
+		}
+	}
+
+	bool isValidPacket(const uint8_t* address, size_t addressLength, const uint8_t* data, size_t count, const uint8_t* crcBytes) const {
+		return computePacket(address, addressLength, data, count) == fromOnAirBytes(crcBytes);
+	}
+};
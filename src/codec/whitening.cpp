@@ -0,0 +1,67 @@
+#include "whitening.h"
+
+
+namespace {
+
+uint8_t reverseBits(uint8_t value) {
+	value = (uint8_t) (((value & 0xF0) >> 4) | ((value & 0x0F) << 4));
+	value = (uint8_t) (((value & 0xCC) >> 2) | ((value & 0x33) << 2));
+	value = (uint8_t) (((value & 0xAA) >> 1) | ((value & 0x55) << 1));
+	return value;
+}
+
+/*
+ * LFSR state left aligned in a byte: bit 7 is output, i.e. DATAWHITEIV bit 0 is LFSR position 6.
+ * Bit 6 of DATAWHITEIV is forced one by hardware.
+ */
+uint8_t initialState(uint8_t dataWhiteIV) {
+	return reverseBits((uint8_t) ((dataWhiteIV | 0x40) & 0x7F));
+}
+
+unsigned int stepLFSR(uint8_t& state) {
+	unsigned int output = state >> 7;
+	if (output)  state ^= 0x11;
+	state = (uint8_t) (state << 1);
+	return output;
+}
+
+/*
+ * Next 8 keystream bits, first in LSB.
+ */
+uint8_t nextKeystreamByte(uint8_t& state) {
+	uint8_t result = 0;
+	for (unsigned int bit = 0; bit < 8; bit++) {
+		result |= (uint8_t) (stepLFSR(state) << bit);
+	}
+	return result;
+}
+
+}  // namespace
+
+
+
+WhiteningKeystream::WhiteningKeystream(uint8_t dataWhiteIV) {
+	uint8_t state = initialState(dataWhiteIV);
+	for (unsigned int i = 0; i < Period; i++) {
+		keystream[i] = nextKeystreamByte(state);
+	}
+}
+
+
+void WhiteningKeystream::apply(uint8_t* data, size_t count, bool isBigEndian) const {
+	size_t index = 0;
+	for (size_t i = 0; i < count; i++) {
+		data[i] ^= isBigEndian ? reverseBits(keystream[index]) : keystream[index];
+		// Avoid modulo per byte
+		if (++index == Period)  index = 0;
+	}
+}
+
+
+void WhiteningKeystream::applyBitwise(uint8_t dataWhiteIV, uint8_t* data, size_t count, bool isBigEndian) {
+	uint8_t state = initialState(dataWhiteIV);
+	for (size_t i = 0; i < count; i++) {
+		uint8_t key = nextKeystreamByte(state);
+		data[i] ^= isBigEndian ? reverseBits(key) : key;
+	}
+}
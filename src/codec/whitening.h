@@ -0,0 +1,43 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>	// size_t
+
+
+/*
+ * Software data whitening matching the radio device (PCNF1.WHITEEN, DATAWHITEIV.)
+ *
+ * 7-bit LFSR, polynomial x^7 + x^4 + 1.
+ * Seeded from DATAWHITEIV: bit 6 always one, bits 0..5 e.g. BLE channel index.
+ * Whitening covers S0, LENGTH, S1, payload and CRC (not preamble, not address.)
+ * Whitening is its own inverse: apply again to dewhiten.
+ *
+ * Keystream is independent of data, with period 127 bits, hence 127 bytes (eight periods of bits.)
+ * WhiteningKeystream precomputes one byte-period, then whitening is one XOR per byte.
+ */
+class WhiteningKeystream {
+public:
+	static const unsigned int Period = 127;
+
+private:
+	uint8_t keystream[Period];	// on-air bit order: first bit in LSB
+
+public:
+	// Argument as written to DATAWHITEIV
+	WhiteningKeystream(uint8_t dataWhiteIV);
+
+	uint8_t byteAt(size_t index) const { return keystream[index % Period]; }
+	unsigned int bitAt(size_t bitIndex) const { return (byteAt(bitIndex / 8) >> (bitIndex % 8)) & 1; }
+
+	/*
+	 * Whiten (or dewhiten) bytes as in RAM, starting at S0 (or at first byte after address.)
+	 * Big endian: each byte goes on-air MSB first (PCNF1.ENDIAN.)
+	 */
+	void apply(uint8_t* data, size_t count, bool isBigEndian = false) const;
+
+
+	/*
+	 * Reference: the LFSR, one bit at a time.
+	 */
+	static void applyBitwise(uint8_t dataWhiteIV, uint8_t* data, size_t count, bool isBigEndian = false);
+};
@@ -8,17 +8,44 @@
 #include "nrf_ppi.h"
 
 
-// hardcoded to channel 0
+namespace {
 
+nrf_ppi_channel_t channelFromIndex(unsigned int channel) { return (nrf_ppi_channel_t) channel; }
+nrf_ppi_channel_group_t groupFromIndex(unsigned int channel) { return (nrf_ppi_channel_group_t) channel; }
+
+/*
+ * Task registers CHG[n].DIS are evenly spaced
+ */
+nrf_ppi_task_t groupDisableTaskFromIndex(unsigned int channel) {
+	return (nrf_ppi_task_t) (NRF_PPI_TASK_CHG0_DIS + channel * (NRF_PPI_TASK_CHG1_DIS - NRF_PPI_TASK_CHG0_DIS));
+}
+
+}  // namespace
+
+
+
+// Without channel parameter, hardcoded to channel 0
 
 void EventToTaskSignal::connect(uint32_t * eventAddress, uint32_t * taskAddress) {
+	connect(0, eventAddress, taskAddress);
+}
+void EventToTaskSignal::connectOneShot(uint32_t * eventAddress, uint32_t * taskAddress) {
+	connectOneShot(0, eventAddress, taskAddress);
+}
+void EventToTaskSignal::enableOneShot() {
+	enableOneShot(0);
+}
+
+
+
+void EventToTaskSignal::connect(unsigned int channel, uint32_t * eventAddress, uint32_t * taskAddress) {
 	// TODO bug in documentation?? requires cast
 	nrf_ppi_channel_endpoint_setup(
-			NRF_PPI_CHANNEL0,
+			channelFromIndex(channel),
 			(uint32_t) eventAddress,
 			(uint32_t) taskAddress);
 
-	nrf_ppi_channel_enable(NRF_PPI_CHANNEL0);
+	nrf_ppi_channel_enable(channelFromIndex(channel));
 }
 
 
@@ -26,23 +53,34 @@ void EventToTaskSignal::connect(uint32_t * eventAddress, uint32_t * taskAddress)
 /*
  * NRF51 has no forks
  */
-void EventToTaskSignal::connectOneShot(uint32_t * eventAddress, uint32_t * taskAddress) {
+void EventToTaskSignal::connectOneShot(unsigned int channel, uint32_t * eventAddress, uint32_t * taskAddress) {
 
 	// connection user wants
-	connect(eventAddress, taskAddress);
+	connect(channel, eventAddress, taskAddress);
 
 	// Fork channel to disable self's group
 	// another cast, bug in docs
-	nrf_ppi_fork_endpoint_setup(NRF_PPI_CHANNEL0,
-			(uint32_t) nrf_ppi_task_address_get(NRF_PPI_TASK_CHG0_DIS));
+	nrf_ppi_fork_endpoint_setup(channelFromIndex(channel),
+			(uint32_t) nrf_ppi_task_address_get(groupDisableTaskFromIndex(channel)));
 
-	// channel 0 in group 0
-	nrf_ppi_channel_include_in_group(NRF_PPI_CHANNEL0, NRF_PPI_CHANNEL_GROUP0);
+	// channel n in group n
+	nrf_ppi_channel_include_in_group(channelFromIndex(channel), groupFromIndex(channel));
 
-	// enable channel group 0
-	enableOneShot();
+	// enable channel group n
+	enableOneShot(channel);
 }
 
-void EventToTaskSignal::enableOneShot() {
-	nrf_ppi_group_enable(NRF_PPI_CHANNEL_GROUP0);
+void EventToTaskSignal::enableOneShot(unsigned int channel) {
+	nrf_ppi_group_enable(groupFromIndex(channel));
+}
+
+
+void EventToTaskSignal::disconnect(unsigned int channel) {
+	nrf_ppi_group_disable(groupFromIndex(channel));
+	nrf_ppi_channel_disable(channelFromIndex(channel));
+}
+
+
+uint32_t* EventToTaskSignal::getDisarmTaskAddress(unsigned int channel) {
+	return nrf_ppi_task_address_get(groupDisableTaskFromIndex(channel));
 }
@@ -10,6 +10,11 @@
  * Facade to PPI device
  *
  * Connects signals from HW events to HW tasks
+ *
+ * Methods without a channel parameter use channel 0 (and group 0.)
+ * Methods with a channel parameter use channel group of same index as channel,
+ * so channel must be less than count of groups (4 on nrf51.)
+ * See hwConfig.h for which channel each user has.
  */
 
 class EventToTaskSignal {
@@ -18,11 +23,25 @@ public:
 	 * Connection always enabled.
 	 */
 	static void connect(uint32_t * eventAddress, uint32_t * taskAddress);
+	static void connect(unsigned int channel, uint32_t * eventAddress, uint32_t * taskAddress);
 
 	/*
 	 * Connection one-shot: disables itself after triggering, and must be reenabled.
 	 */
 	static void connectOneShot(uint32_t * eventAddress, uint32_t * taskAddress);
+	static void connectOneShot(unsigned int channel, uint32_t * eventAddress, uint32_t * taskAddress);
 
 	static void enableOneShot();
+	static void enableOneShot(unsigned int channel);
+
+	/*
+	 * Disable channel (and its group.)  Endpoints remain, but no signal.
+	 */
+	static void disconnect(unsigned int channel);
+
+	/*
+	 * Task that disables the one-shot group of channel, i.e. disarms a connectOneShot() channel.
+	 * For connecting another channel's event to it (an event that cancels a one-shot.)
+	 */
+	static uint32_t* getDisarmTaskAddress(unsigned int channel);
 };
@@ -39,3 +39,15 @@
  * Configure how many RTC compare registers have facades.
  */
 #define COMPARE_REG_COUNT 3
+
+
+/*
+ * Configure which PPI channels in use (see EventToTaskSignal.)
+ * Channel 0 is the default channel (e.g. PinTask.)
+ * Each channel is also a one-shot group of same index.
+ */
+#define RadioTimedStartPPIChannel 1
+// Closes radio listen windows (RTC compare -> DISABLE)
+#define RadioWindowPPIChannel 2
+// Extends radio listen windows (RADIO ADDRESS -> disarm RadioWindowPPIChannel)
+#define RadioWindowExtendPPIChannel 3
@@ -102,6 +102,23 @@ bool MCU::isDebugMode() {
 }
 
 
+void MCU::enableCycleCounter() {
+#ifdef NRF52_SERIES
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t MCU::cycleCount() {
+#ifdef NRF52_SERIES
+	return DWT->CYCCNT;
+#else
+	return 0;
+#endif
+}
+
+
 /*
  * RESETREAS register is cumulative through resetpin, soft, dog, lockup, and wake-from-off resets.
  * POR and Brownout resets clear it.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <inttypes.h>
+
 /*
  * "driver" for microcontroller device, i.e. the ARM cpu as distinguished from independent peripherals.
  * Hides target specifics.
@@ -54,6 +56,13 @@ public:
 	 */
 	static bool isDebugMode();
 
+	/*
+	 * CPU cycle counter (DWT CYCCNT), e.g. for benchmarks.  Wraps at 2^32.
+	 * Only NRF52_SERIES: nrf51 (Cortex-M0) has no cycle counter, count is always zero.
+	 */
+	static void enableCycleCounter();
+	static uint32_t cycleCount();
+
 	/*
 	 * If ARM debug mode is enabled, enter Debug mode, else generate hardfault.
 	 * If a debugging probe is attached, the probe enables debug mode and controls the app,
@@ -0,0 +1,193 @@
+#include <cassert>
+
+#include "adaptiveXmitPower.h"
+#include "radio.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Path loss is kept in 1/16 dB (fixed point) so the moving average does not stall on integer rounding.
+ * Level is an index into Levels, so stepping is index arithmetic.
+ * floorLevelIndex is held by fallback: adaptLevel() never steps below it while holdAcks is nonzero.
+ */
+
+const int8_t AdaptiveXmitPower::Levels[AdaptiveXmitPower::LevelCount] = { -40, -20, -16, -12, -8, -4, 0, 4 };
+
+namespace {
+
+const unsigned int MaxLevelIndex = AdaptiveXmitPower::LevelCount - 1;
+const int FractionScale = 16;
+
+struct PeerState {
+	bool isUsed;
+	bool isPathLossKnown;
+	uint8_t peer;
+	uint8_t levelIndex;
+	uint8_t missedAcks;
+	uint8_t floorLevelIndex;
+	uint8_t holdAcks;
+	int32_t pathLoss;	// 1/16 dB
+	uint32_t lastUsed;
+};
+
+PeerState peers[AdaptiveXmitPower::MaxPeerCount];
+uint32_t useCount = 0;
+
+int8_t targetRSSI = -80;
+uint8_t hysteresis = 3;
+uint8_t missedAckLimit = 2;
+
+
+PeerState* find(uint8_t peer) {
+	for (unsigned int i = 0; i < AdaptiveXmitPower::MaxPeerCount; i++) {
+		if (peers[i].isUsed && peers[i].peer == peer) {
+			peers[i].lastUsed = ++useCount;
+			return &peers[i];
+		}
+	}
+	return nullptr;
+}
+
+/*
+ * New peer starts at full power.
+ */
+PeerState& findOrAdd(uint8_t peer) {
+	PeerState* result = find(peer);
+	if (result != nullptr) {
+		return *result;
+	}
+
+	PeerState* victim = &peers[0];
+	for (unsigned int i = 0; i < AdaptiveXmitPower::MaxPeerCount; i++) {
+		if (!peers[i].isUsed) {
+			victim = &peers[i];
+			break;
+		}
+		if (peers[i].lastUsed < victim->lastUsed) {
+			victim = &peers[i];
+		}
+	}
+	victim->isUsed = true;
+	victim->isPathLossKnown = false;
+	victim->peer = peer;
+	victim->levelIndex = MaxLevelIndex;
+	victim->missedAcks = 0;
+	victim->floorLevelIndex = 0;
+	victim->holdAcks = 0;
+	victim->pathLoss = 0;
+	victim->lastUsed = ++useCount;
+	return *victim;
+}
+
+/*
+ * Lowest level at which received power is at least required, else highest level.
+ */
+uint8_t lowestLevelAtLeast(int requiredDBm) {
+	for (unsigned int i = 0; i < MaxLevelIndex; i++) {
+		if (AdaptiveXmitPower::Levels[i] >= requiredDBm) {
+			return i;
+		}
+	}
+	return MaxLevelIndex;
+}
+
+void adaptLevel(PeerState& state) {
+	// Round up: err toward more power
+	int pathLossDB = (state.pathLoss + FractionScale - 1) / FractionScale;
+	int requiredDBm = targetRSSI + pathLossDB;
+
+	uint8_t upLevel = lowestLevelAtLeast(requiredDBm);
+	if (upLevel > state.levelIndex) {
+		state.levelIndex = upLevel;
+		return;
+	}
+	uint8_t downLevel = lowestLevelAtLeast(requiredDBm + hysteresis);
+	if (state.holdAcks > 0 && downLevel < state.floorLevelIndex) {
+		downLevel = state.floorLevelIndex;
+	}
+	if (downLevel < state.levelIndex) {
+		state.levelIndex = downLevel;
+	}
+}
+
+}  // namespace
+
+
+
+void AdaptiveXmitPower::configure(int8_t aTargetRSSIDBm, uint8_t aHysteresisDB, uint8_t aMissedAckLimit) {
+	assert(aMissedAckLimit > 0);
+	targetRSSI = aTargetRSSIDBm;
+	hysteresis = aHysteresisDB;
+	missedAckLimit = aMissedAckLimit;
+}
+
+void AdaptiveXmitPower::reset() {
+	for (unsigned int i = 0; i < MaxPeerCount; i++) {
+		peers[i].isUsed = false;
+	}
+	useCount = 0;
+}
+
+
+
+void AdaptiveXmitPower::onReceived(uint8_t peer, unsigned int signalStrength, int8_t peerXmitPowerDBm) {
+	PeerState& state = findOrAdd(peer);
+
+	// RSSI is -signalStrength dBm
+	int32_t sample = (peerXmitPowerDBm + (int) signalStrength) * FractionScale;
+	if (state.isPathLossKnown) {
+		state.pathLoss += (sample - state.pathLoss) / 4;
+	}
+	else {
+		state.pathLoss = sample;
+		state.isPathLossKnown = true;
+	}
+	adaptLevel(state);
+}
+
+void AdaptiveXmitPower::onAckReceived(uint8_t peer) {
+	PeerState* state = find(peer);
+	if (state != nullptr) {
+		state->missedAcks = 0;
+		if (state->holdAcks > 0) {
+			state->holdAcks--;
+		}
+	}
+}
+
+void AdaptiveXmitPower::onAckMissed(uint8_t peer) {
+	PeerState* state = find(peer);
+	if (state == nullptr) {
+		// Already at full power
+		return;
+	}
+
+	state->missedAcks++;
+	if (state->missedAcks >= missedAckLimit) {
+		state->levelIndex = MaxLevelIndex;
+		state->isPathLossKnown = false;
+	}
+	else if (state->levelIndex < MaxLevelIndex) {
+		state->levelIndex++;
+	}
+	// Hold the raised level
+	state->floorLevelIndex = state->levelIndex;
+	state->holdAcks = FallbackHoldAckCount;
+}
+
+
+
+int8_t AdaptiveXmitPower::powerFor(uint8_t peer) {
+	PeerState* state = find(peer);
+	return Levels[state != nullptr ? state->levelIndex : MaxLevelIndex];
+}
+
+void AdaptiveXmitPower::configureXmitPowerFor(uint8_t peer) {
+	RadioDevice::configureXmitPower(powerFor(peer));
+}
+
+int AdaptiveXmitPower::smoothedPathLossDB(uint8_t peer) {
+	PeerState* state = find(peer);
+	return (state != nullptr && state->isPathLossKnown) ? state->pathLoss / FractionScale : 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * Closed loop transmit power per peer.
+ *
+ * Per peer, tracks smoothed path loss from the RSSI of packets received from the peer
+ * (links are reciprocal enough: path loss = peer's transmit power - RSSI here.)
+ * Picks the lowest TXPOWER level at which the peer should receive at targetRSSI (sensitivity plus margin.)
+ *
+ * - smoothing: exponential moving average, weight 1/4 to each new sample
+ * - hysteresis: steps down only when a lower level still clears the target by hysteresisDB; steps up at once
+ * - fast fallback: one missed ack steps up a level; missedAckLimit consecutive misses jump to full power
+ *   and forget the smoothed path loss, which then converges down again from new samples.
+ *   The raised level is a floor that stepping down does not undercut, until FallbackHoldAckCount acks arrive
+ *   (else the next received packet, typically the retry's ack, steps straight back down.)
+ *
+ * Unknown peers (never heard, or evicted from the table) get full power.
+ * Peer is whatever the app uses to tell peers apart, e.g. logical address or a byte of the sender's ID.
+ *
+ * Singleton, all static class methods.
+ * Not for concurrent use from ISR and app: call from one context.
+ */
+class AdaptiveXmitPower {
+public:
+	// Least recently used peer is evicted when full
+	static const unsigned int MaxPeerCount = 8;
+	// Acks received after a missed ack before the level may step below the fallback level
+	static const unsigned int FallbackHoldAckCount = 4;
+
+	// Levels configureXmitPower() accepts, ascending
+	static const unsigned int LevelCount = 8;
+	static const int8_t Levels[LevelCount];
+
+	static void configure(int8_t targetRSSIDBm, uint8_t hysteresisDB, uint8_t missedAckLimit);
+	static void reset();
+
+	/*
+	 * signalStrength as from RadioDevice::receivedSignalStrength() (magnitude of negative dBm.)
+	 * peerXmitPowerDBm is the power the peer sent at, if it says, else the peer's usual power.
+	 */
+	static void onReceived(uint8_t peer, unsigned int signalStrength, int8_t peerXmitPowerDBm);
+	static void onAckReceived(uint8_t peer);
+	static void onAckMissed(uint8_t peer);
+
+	static int8_t powerFor(uint8_t peer);
+	// RadioDevice::configureXmitPower(powerFor(peer))
+	static void configureXmitPowerFor(uint8_t peer);
+
+	// For telemetry.  Zero if unknown peer.
+	static int smoothedPathLossDB(uint8_t peer);
+};
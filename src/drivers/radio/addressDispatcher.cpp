@@ -0,0 +1,55 @@
+#include <cassert>
+
+#include "addressDispatcher.h"
+#include "radio.h"
+
+
+namespace {
+
+ReceivedPacketCallback handlers[8] = { nullptr };
+
+unsigned int unhandled = 0;
+
+}  // namespace
+
+
+
+void LogicalAddressDispatcher::registerHandler(const uint8_t logicalAddress, ReceivedPacketCallback callback) {
+	assert(logicalAddress < 8);
+	handlers[logicalAddress] = callback;
+}
+
+void LogicalAddressDispatcher::unregisterHandler(const uint8_t logicalAddress) {
+	assert(logicalAddress < 8);
+	handlers[logicalAddress] = nullptr;
+}
+
+
+uint8_t LogicalAddressDispatcher::handledAddressMask() {
+	uint8_t mask = 0;
+	for (unsigned int i = 0; i < 8; i++) {
+		if (handlers[i] != nullptr)  mask |= (1 << i);
+	}
+	return mask;
+}
+
+void LogicalAddressDispatcher::configureRXForHandledAddresses() {
+	RadioDevice::configureRXLogicalAddresses(handledAddressMask());
+}
+
+
+void LogicalAddressDispatcher::dispatch(RadioBufferPointer buffer) {
+	dispatch(buffer, RadioDevice::receivedLogicalAddress());
+}
+
+void LogicalAddressDispatcher::dispatch(RadioBufferPointer buffer, const uint8_t aLogicalAddress) {
+	// RXMATCH is [0..7]
+	uint8_t logicalAddress = aLogicalAddress & 0x7;
+
+	if (handlers[logicalAddress] != nullptr)
+		handlers[logicalAddress](buffer);
+	else
+		unhandled++;
+}
+
+unsigned int LogicalAddressDispatcher::unhandledCount() { return unhandled; }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "types.h"	// RadioBufferPointer, ReceivedPacketCallback
+
+
+/*
+ * Dispatches received packets to a handler per logical address.
+ *
+ * Hardware address matching (RXADDRESSES) separates traffic classes:
+ * the radio only receives on logical addresses that have a handler,
+ * and RXMATCH tells which one matched.
+ *
+ * Singleton, all static class methods.
+ */
+class LogicalAddressDispatcher {
+public:
+	static void registerHandler(const uint8_t logicalAddress, ReceivedPacketCallback);
+	static void unregisterHandler(const uint8_t logicalAddress);
+
+	/*
+	 * Mask of logical addresses having a handler.
+	 */
+	static uint8_t handledAddressMask();
+
+	/*
+	 * Set RXADDRESSES to handledAddressMask()
+	 */
+	static void configureRXForHandledAddresses();
+
+	/*
+	 * Call handler for RadioDevice::receivedLogicalAddress().
+	 * Call after END, before next packet (RXMATCH is for most recent packet.)
+	 *
+	 * Does not check CRC.
+	 */
+	static void dispatch(RadioBufferPointer buffer);
+	/*
+	 * When the logical address was recorded earlier, e.g. by ContinuousReceiver.
+	 */
+	static void dispatch(RadioBufferPointer buffer, const uint8_t logicalAddress);
+
+	/*
+	 * Count of packets dispatched to a logical address having no handler.
+	 */
+	static unsigned int unhandledCount();
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "nrf.h"
+
+#include "radioConfig.h"
+#include "radioModes.h"
+
+
+/*
+ * On-air time of packets, and minimum receive windows.
+ *
+ * All constexpr: from a constexpr RadioConfig (see StaticRadioConfig) the results are compile time constants.
+ * Decodes the same register words the radio uses:
+ * - MODE: bitrate (RadioModes::modeOf, then the constants per mode of RadioModes)
+ * - PCNF0: preamble length (PLEN), S0, LENGTH, S1 field lengths
+ * - PCNF1: base address length (BALEN), STATLEN
+ * - CRCCNF: CRC length
+ * - MODECNF0: ramp up fast or not (RadioModes::rampUpMicroseconds)
+ *
+ * Times in microseconds, rounded up.
+ */
+class RadioAirtime {
+public:
+	// Counter (RTC) tick is 1/32768 sec
+	static constexpr uint32_t TicksPerSecond = 32768;
+
+
+	static constexpr uint32_t bitsToMicroseconds(uint32_t bits, uint32_t mode) {
+		return (bits * 1000 + RadioModes::kilobitsPerSecond(RadioModes::modeOf(mode)) - 1)
+				/ RadioModes::kilobitsPerSecond(RadioModes::modeOf(mode));
+	}
+
+	/*
+	 * Bytes in the register, bits on-air.
+	 */
+	static constexpr uint32_t preambleBits(uint32_t pcnf0) {
+#ifdef NRF52_SERIES
+		return ((pcnf0 & RADIO_PCNF0_PLEN_Msk) >> RADIO_PCNF0_PLEN_Pos) == RADIO_PCNF0_PLEN_16bit ? 16 : 8;
+#else
+		return 8;
+#endif
+	}
+	// BALEN is base length, plus one byte prefix
+	static constexpr uint32_t addressBits(uint32_t pcnf1) {
+		return 8 * (((pcnf1 & RADIO_PCNF1_BALEN_Msk) >> RADIO_PCNF1_BALEN_Pos) + 1);
+	}
+	static constexpr uint32_t headerBits(uint32_t pcnf0) {
+		return 8 * ((pcnf0 & RADIO_PCNF0_S0LEN_Msk) >> RADIO_PCNF0_S0LEN_Pos)
+				+ ((pcnf0 & RADIO_PCNF0_LFLEN_Msk) >> RADIO_PCNF0_LFLEN_Pos)
+				+ ((pcnf0 & RADIO_PCNF0_S1LEN_Msk) >> RADIO_PCNF0_S1LEN_Pos);
+	}
+	static constexpr uint32_t staticLength(uint32_t pcnf1) {
+		return (pcnf1 & RADIO_PCNF1_STATLEN_Msk) >> RADIO_PCNF1_STATLEN_Pos;
+	}
+	static constexpr uint32_t crcBits(uint32_t crccnf) {
+		return 8 * ((crccnf & RADIO_CRCCNF_LEN_Msk) >> RADIO_CRCCNF_LEN_Pos);
+	}
+
+
+	/*
+	 * Preamble and address: time until ADDRESS event, i.e. until receiver knows a packet is in flight.
+	 */
+	static constexpr uint32_t syncMicroseconds(const RadioConfig& config) {
+		return bitsToMicroseconds(preambleBits(config.packetConfig0) + addressBits(config.packetConfig1), config.mode);
+	}
+
+	/*
+	 * Whole packet: preamble, address, S0, LENGTH, S1, payload, CRC.
+	 * payloadCount is LENGTH field value (dynamic format);
+	 * on-air payload is STATLEN bytes more (zero in dynamic format, all of it in static format.)
+	 */
+	static constexpr uint32_t packetMicroseconds(const RadioConfig& config, uint32_t payloadCount) {
+		return bitsToMicroseconds(
+				preambleBits(config.packetConfig0)
+				+ addressBits(config.packetConfig1)
+				+ headerBits(config.packetConfig0)
+				+ 8 * (payloadCount + staticLength(config.packetConfig1))
+				+ crcBits(config.crcConfig),
+				config.mode);
+	}
+
+	// MODECNF0 is only on nrf52
+	static constexpr bool isFastRampUp(uint32_t modeConfig) {
+#ifdef NRF52_SERIES
+		return (modeConfig & RADIO_MODECNF0_RU_Msk) == (RADIO_MODECNF0_RU_Fast << RADIO_MODECNF0_RU_Pos);
+#else
+		return false;
+#endif
+	}
+
+	static constexpr uint32_t rampUpMicroseconds(const RadioConfig& config) {
+		return RadioModes::rampUpMicroseconds(RadioModes::modeOf(config.mode), isFastRampUp(config.modeConfig));
+	}
+
+	/*
+	 * From start task (TXEN) to END: what the radio is powered for one transmit.
+	 */
+	static constexpr uint32_t transmitMicroseconds(const RadioConfig& config, uint32_t payloadCount) {
+		return rampUpMicroseconds(config) + packetMicroseconds(config, payloadCount);
+	}
+
+
+	/*
+	 * Minimum receive window, in microseconds, from RXEN, for a sender scheduled to TXEN at the same nominal time.
+	 *
+	 * Guard on both sides of nominal time for:
+	 * - clock drift of both parties over the interval since last synchronization (driftPPM is sum of both)
+	 * - timing uncertainty, e.g. one tick of each party's Counter
+	 * Then receiver must ramp up, and see preamble and address (ADDRESS event.)
+	 * After ADDRESS, the window must stay open until END (packetMicroseconds.)
+	 */
+	static constexpr uint32_t guardMicroseconds(uint32_t intervalMicroseconds, uint32_t driftPPM, uint32_t uncertaintyMicroseconds) {
+		return (uint32_t) (((uint64_t) intervalMicroseconds * driftPPM + 999999) / 1000000) + uncertaintyMicroseconds;
+	}
+
+	static constexpr uint32_t minimumRXWindowMicroseconds(
+			const RadioConfig& config,
+			uint32_t intervalMicroseconds,
+			uint32_t driftPPM,
+			uint32_t uncertaintyMicroseconds)
+	{
+		return rampUpMicroseconds(config)
+				+ 2 * guardMicroseconds(intervalMicroseconds, driftPPM, uncertaintyMicroseconds)
+				+ syncMicroseconds(config);
+	}
+
+	/*
+	 * Receiver should RXEN this long before nominal time.
+	 */
+	static constexpr uint32_t rxLeadMicroseconds(uint32_t intervalMicroseconds, uint32_t driftPPM, uint32_t uncertaintyMicroseconds) {
+		return guardMicroseconds(intervalMicroseconds, driftPPM, uncertaintyMicroseconds);
+	}
+
+	/*
+	 * Round up to Counter ticks.
+	 */
+	static constexpr uint32_t microsecondsToTicks(uint32_t microseconds) {
+		return (uint32_t) (((uint64_t) microseconds * TicksPerSecond + 999999) / 1000000);
+	}
+};
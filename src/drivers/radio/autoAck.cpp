@@ -0,0 +1,164 @@
+#include <cassert>
+
+#include "autoAck.h"
+#include "radio.h"
+#include "receiveWindow.h"
+
+
+namespace {
+
+enum class AutoAckState {
+	Idle,
+	Transmitting,	// sender
+	AwaitingAck,	// sender
+	Receiving,	// receiver
+	SendingAck	// receiver
+};
+
+volatile AutoAckState state = AutoAckState::Idle;
+
+RadioBufferPointer ackBufferPtr = nullptr;
+
+bool isWindowConfigured = false;
+bool isAddressEventInWindow = false;
+bool _isAcked = false;
+bool _isReceivedCRCValid = false;
+
+
+void enableInterrupts() {
+	RadioDevice::clearReceiveInProgressEvent();
+	RadioDevice::clearDisabledEvent();
+	RadioDevice::enableInterruptForAddressEvent();
+	RadioDevice::enableInterruptForDisabledEvent();
+}
+
+void disableInterrupts() {
+	RadioDevice::disableInterruptForAddressEvent();
+	RadioDevice::disableInterruptForDisabledEvent();
+}
+
+}  // namespace
+
+
+
+void AutoAck::configureAckWindow(const CompareRegister& compareRegister, const uint32_t aWindowTicks) {
+	ReceiveWindow::configure(compareRegister, aWindowTicks);
+	isWindowConfigured = true;
+}
+
+
+void AutoAck::transmitExpectingAck(RadioBufferPointer packet, RadioBufferPointer ackBuffer) {
+	assert(state == AutoAckState::Idle);
+	assert(isWindowConfigured);
+
+	ackBufferPtr = ackBuffer;
+	_isAcked = false;
+	isAddressEventInWindow = false;
+
+	RadioDevice::configurePacketAddress(packet);
+	RadioDevice::setShortcuts(RadioShortcutProfile::TransmitThenReceive);
+	enableInterrupts();
+	state = AutoAckState::Transmitting;
+	RadioDevice::startTXTask();
+}
+
+
+void AutoAck::receiveAndAck(RadioBufferPointer packet, RadioBufferPointer ackBuffer) {
+	assert(state == AutoAckState::Idle);
+
+	ackBufferPtr = ackBuffer;
+	_isReceivedCRCValid = false;
+
+	RadioDevice::configurePacketAddress(packet);
+	RadioDevice::setShortcuts(RadioShortcutProfile::ReceiveThenTransmit);
+	enableInterrupts();
+	state = AutoAckState::Receiving;
+	RadioDevice::startRXTask();
+}
+
+
+void AutoAck::cancel() {
+	disableInterrupts();
+	RadioDevice::clearTurnaroundShortcuts();
+	if (state == AutoAckState::AwaitingAck)  ReceiveWindow::disarm();
+
+	RadioDevice::startDisablingTask();
+	while (!RadioDevice::isDisabledState()) {}
+	RadioDevice::clearDisabledEvent();
+	state = AutoAckState::Idle;
+}
+
+
+bool AutoAck::isDone() { return state == AutoAckState::Idle; }
+bool AutoAck::isAcked() { return _isAcked; }
+bool AutoAck::isReceivedCRCValid() { return _isReceivedCRCValid; }
+
+
+
+void AutoAck::radioISR() {
+	// Reads and clears
+	if (RadioDevice::isReceiveInProgressEvent()) {
+		onAddressEvent();
+	}
+	if (RadioDevice::isDisabledEventSet()) {
+		RadioDevice::clearDisabledEvent();
+		onDisabledEvent();
+	}
+}
+
+
+/*
+ * First packet (TX or RX) has latched PACKETPTR, so point it at the ack buffer for the turnaround.
+ * During the ack window, an ack is in flight: ReceiveWindow has already (in hardware) kept the window from closing on it.
+ */
+void AutoAck::onAddressEvent() {
+	switch(state) {
+	case AutoAckState::Transmitting:
+	case AutoAckState::Receiving:
+		RadioDevice::configureNextPacketAddress(ackBufferPtr);
+		break;
+	case AutoAckState::AwaitingAck:
+		isAddressEventInWindow = true;
+		break;
+	default:
+		break;
+	}
+}
+
+
+/*
+ * On first DISABLED, the turnaround shortcut has already enabled the opposite direction.
+ * Clear it so the second DISABLED ends the exchange.
+ */
+void AutoAck::onDisabledEvent() {
+	switch(state) {
+	case AutoAckState::Transmitting:
+		RadioDevice::clearTurnaroundShortcuts();
+		ReceiveWindow::arm();
+		state = AutoAckState::AwaitingAck;
+		break;
+
+	case AutoAckState::AwaitingAck:
+		// Either ack received (END->DISABLE) or window closed (PPI->DISABLE)
+		ReceiveWindow::disarm();
+		_isAcked = isAddressEventInWindow and RadioDevice::isCRCValid();
+		disableInterrupts();
+		state = AutoAckState::Idle;
+		break;
+
+	case AutoAckState::Receiving:
+		RadioDevice::clearTurnaroundShortcuts();
+		// CRCSTATUS is for received packet, TX does not change it
+		_isReceivedCRCValid = RadioDevice::isCRCValid();
+		state = AutoAckState::SendingAck;
+		break;
+
+	case AutoAckState::SendingAck:
+		disableInterrupts();
+		state = AutoAckState::Idle;
+		break;
+
+	default:
+		break;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+#include "../clock/compareRegister.h"
+
+
+/*
+ * Acknowledge with hardware turnaround (shortcuts DISABLED_RXEN / DISABLED_TXEN.)
+ *
+ * Sender:
+ * transmitExpectingAck(): TX packet, radio turns around to RX in hardware, receives ack into ack buffer.
+ * The ack window is a ReceiveWindow: closed by RTC compare -> PPI -> DISABLE, unless an ack is in flight.
+ *
+ * Receiver:
+ * receiveAndAck(): RX packet, radio turns around to TX in hardware, transmits prebuilt ack buffer.
+ * !!! Ack is sent for any packet matching address, even one with CRC error:
+ * the decision to turnaround is made by hardware before CRC is known.
+ * Sender must check the ack contents if that matters.
+ *
+ * Latency from END of packet to ack is the ramp-up time (see configureFastRampUp), not ISR latency.
+ * The ISR still runs, but only to swap PACKETPTR and clear the turnaround shortcut, both off the critical path.
+ *
+ * Singleton, all static class methods.
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler.
+ * Radio must be configured (address, format, CRC) and DISABLED before calling.
+ */
+class AutoAck {
+public:
+	/*
+	 * Window in ticks of Counter after turnaround starts.
+	 * Must cover ramp-up and on-air time of ack (at least 2 ticks, per RTC.)
+	 * Configures ReceiveWindow (shares its PPI channels)
+	 */
+	static void configureAckWindow(const CompareRegister&, const uint32_t windowTicks);
+
+	static void transmitExpectingAck(RadioBufferPointer packet, RadioBufferPointer ackBuffer);
+	static void receiveAndAck(RadioBufferPointer packet, RadioBufferPointer ackBuffer);
+
+	/*
+	 * Abandon exchange, e.g. receiver heard nothing.
+	 * !!! Do not simply startDisablingTask(): a receiver would turnaround and send an ack.
+	 */
+	static void cancel();
+
+	/*
+	 * Radio back to DISABLED, exchange complete.
+	 */
+	static bool isDone();
+
+	// Sender result: ack received with valid CRC.
+	static bool isAcked();
+	// Receiver result: packet received (ack was sent) with valid CRC
+	static bool isReceivedCRCValid();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 */
+	static void radioISR();
+	static void onAddressEvent();
+	static void onDisabledEvent();
+};
@@ -0,0 +1,160 @@
+#include <cassert>
+
+#include "bleBeacon.h"
+#include "radio.h"
+#include "dynamicPacket.h"
+#include "../uniqueID.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * PDU in RAM as the radio sees it with S0 one byte, LENGTH 8 bits, no S1.
+ * Header byte: PDU type in bits 0-3, TxAdd in bit 6.
+ * Access address 0x8E89BED6: prefix 0x8E on AP0, base 0x89BED6 (BALEN 3), sent LSB first.
+ *
+ * Channel index is also the whitening seed (BLE spec: whitening initialized from the channel index.)
+ */
+
+namespace {
+
+const uint8_t PDUTypeADVNonConnInd = 0x2;
+const uint8_t TxAddRandom = 1 << 6;
+
+const unsigned int HeaderLength = 2;	// S0, LENGTH
+const unsigned int AdvALength = 6;
+const unsigned int MaxPDULength = AdvALength + BLEBeacon::MaxAdvertisingDataLength;
+
+const uint32_t AccessAddressBase = 0x89BED600;
+const uint8_t AccessAddressPrefix = 0x8E;
+
+struct AdvertisingChannel {
+	uint8_t frequency;	// MHz above 2400
+	uint8_t index;
+};
+
+const AdvertisingChannel Channels[] = { { 2, 37 }, { 26, 38 }, { 80, 39 } };
+const unsigned int ChannelCount = sizeof(Channels) / sizeof(Channels[0]);
+
+
+uint8_t pdu[HeaderLength + MaxPDULength];
+uint8_t advertisingDataLength = 0;
+
+volatile unsigned int nextChannel = ChannelCount;
+
+
+void setLength() {
+	pdu[1] = AdvALength + advertisingDataLength;
+}
+
+void tuneTo(const AdvertisingChannel& channel) {
+	RadioDevice::configureFixedFrequency(channel.frequency);
+	RadioDevice::configureWhiteningSeed(channel.index);
+}
+
+/*
+ * Radio DISABLED.
+ */
+void sendOnNextChannel() {
+	tuneTo(Channels[nextChannel]);
+	nextChannel = nextChannel + 1;
+	RadioDevice::startTXTask();
+}
+
+}  // namespace
+
+
+
+void BLEBeacon::setAdvertiserAddress(uint64_t address) {
+	assert(((address >> 46) & 0x3) == 0x3);
+	for (unsigned int i = 0; i < AdvALength; i++) {
+		pdu[HeaderLength + i] = (uint8_t) (address >> (8 * i));
+	}
+}
+
+void BLEBeacon::setAdvertiserAddressFromDeviceID() {
+	setAdvertiserAddress(SystemProperties::deviceID() | (0x3ull << 46));
+}
+
+
+void BLEBeacon::clearAdvertisingData() {
+	advertisingDataLength = 0;
+	setLength();
+}
+
+bool BLEBeacon::addADStructure(uint8_t type, const uint8_t* data, uint8_t length) {
+	// Length byte counts type byte and data
+	if (advertisingDataLength + 2 + length > MaxAdvertisingDataLength) {
+		return false;
+	}
+
+	uint8_t* next = &pdu[HeaderLength + AdvALength + advertisingDataLength];
+	*next++ = length + 1;
+	*next++ = type;
+	for (unsigned int i = 0; i < length; i++) {
+		*next++ = data[i];
+	}
+	advertisingDataLength += 2 + length;
+	setLength();
+	return true;
+}
+
+
+
+void BLEBeacon::configureRadio(int8_t xmitPowerDBm) {
+	assert(RadioDevice::isDisabledState());
+
+	DynamicPacketFormat format = { 1, 8, 0 };
+	RadioDevice::configureDynamicPacketFormat(format, MaxPDULength, 4);
+	RadioDevice::configureWhiteningOn();
+
+	RadioDevice::configureBaseAddress(0, AccessAddressBase);
+	RadioDevice::configurePrefix(0, AccessAddressPrefix);
+	RadioDevice::configureTXLogicalAddress(0);
+	RadioDevice::configureRXLogicalAddresses(1 << 0);
+
+	RadioDevice::configureMode(RadioMode::Ble1Mbit);
+	RadioDevice::configureBLECRC();
+	RadioDevice::configureXmitPower(xmitPowerDBm);
+
+	pdu[0] = PDUTypeADVNonConnInd | TxAddRandom;
+	setLength();
+}
+
+
+void BLEBeacon::advertise() {
+	assert(isDone());
+	assert(RadioDevice::isDisabledState());
+
+	RadioDevice::configurePacketAddress(pdu);
+	RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+
+	RadioDevice::clearDisabledEvent();
+	RadioDevice::enableInterruptForDisabledEvent();
+
+	nextChannel = 0;
+	sendOnNextChannel();
+}
+
+/*
+ * Done when the last channel's packet has disabled the radio.
+ */
+bool BLEBeacon::isDone() { return nextChannel == ChannelCount && RadioDevice::isDisabledState(); }
+
+
+
+void BLEBeacon::radioISR() {
+	if (RadioDevice::isDisabledEventSet()) {
+		RadioDevice::clearDisabledEvent();
+		onDisabledEvent();
+	}
+}
+
+void BLEBeacon::onDisabledEvent() {
+	if (nextChannel < ChannelCount) {
+		sendOnNextChannel();
+	}
+	else {
+		RadioDevice::disableInterruptForDisabledEvent();
+	}
+}
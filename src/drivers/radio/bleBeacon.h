@@ -0,0 +1,67 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * BLE non-connectable advertising (beacon), on the raw radio, without SoftDevice.
+ *
+ * Builds an ADV_NONCONN_IND PDU in a private buffer:
+ * - header (S0): PDU type, TxAdd (advertiser address is random)
+ * - LENGTH: 6 (AdvA) + AdvData length
+ * - AdvA: 6 bytes, little endian
+ * - AdvData: AD structures (length, type, data), at most 31 bytes total
+ *
+ * One advertising event sends the PDU once on each of channels 37, 38, 39, back-to-back.
+ * Shortcuts READY->START and END->DISABLE run each packet without the cpu.
+ * The ISR on DISABLED retunes FREQUENCY and DATAWHITEIV (writable only in DISABLED) and starts TXEN.
+ * So an event is one wake of the app plus three short ISRs,
+ * about 3 * (ramp up + 376 uSec max PDU) of radio time, less with short AdvData.
+ *
+ * The app schedules events (advertising interval plus 0-10 mSec random delay, per BLE spec), e.g. with a Timer.
+ *
+ * Configuring for BLE destroys the app's own protocol configuration (packet format, address, CRC, mode.)
+ * When sharing the radio, reconfigure after the event, or use applyConfiguration().
+ *
+ * Singleton, all static class methods.
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler.
+ */
+class BLEBeacon {
+public:
+	static const uint8_t MaxAdvertisingDataLength = 31;
+
+	// AD types (Bluetooth Assigned Numbers)
+	static const uint8_t ADTypeFlags = 0x01;
+	static const uint8_t ADTypeCompleteLocalName = 0x09;
+	static const uint8_t ADTypeManufacturerSpecificData = 0xFF;
+
+	/*
+	 * Static random address: the top two bits of the most significant byte must be ones.
+	 * Address is 48 bits, the upper bits of parameter are ignored.
+	 */
+	static void setAdvertiserAddress(uint64_t address);
+	// From SystemProperties::deviceID(), so stable across resets
+	static void setAdvertiserAddressFromDeviceID();
+
+	static void clearAdvertisingData();
+	/*
+	 * Returns false (and adds nothing) if the AD structure would not fit.
+	 */
+	static bool addADStructure(uint8_t type, const uint8_t* data, uint8_t length);
+
+	/*
+	 * Radio powered on and DISABLED.
+	 * BLE 1M mode, access address 0x8E89BED6, CRC 0x555555/0x00065B, whitening.
+	 */
+	static void configureRadio(int8_t xmitPowerDBm);
+
+	/*
+	 * Start one advertising event.  Returns at once, isDone() when all three channels sent.
+	 * Radio configured and DISABLED.
+	 */
+	static void advertise();
+	static bool isDone();
+
+	static void radioISR();
+	static void onDisabledEvent();
+};
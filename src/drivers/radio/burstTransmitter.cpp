@@ -0,0 +1,154 @@
+#include <cassert>
+
+#include "burstTransmitter.h"
+#include "radio.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Single producer (app) and single consumer (ISR), like ContinuousReceiver.
+ * App writes only enqueuedSequence, ISR writes sentSequence and armedSequence.
+ *
+ * Buffers in [sentSequence, enqueuedSequence) are owned by the radio.
+ * Buffer sentSequence is on-air (or about to be.)
+ * armedSequence is the buffer PACKETPTR holds: at ADDRESS, the packet on-air.
+ * So ADDRESS arms armedSequence + 1, whether or not END of the previous packet was handled yet.
+ * Whether next buffer was armed is decided once per packet, at its ADDRESS.
+ */
+
+namespace {
+
+RadioBufferPointer queue[BurstTransmitter::MaxQueueCount];
+
+volatile unsigned int enqueuedSequence = 0;
+volatile unsigned int sentSequence = 0;
+unsigned int armedSequence = 0;
+
+volatile bool _isBusy = false;
+
+
+unsigned int indexOf(unsigned int sequence) {
+	return sequence & (BurstTransmitter::MaxQueueCount - 1);
+}
+
+void enableInterrupts() {
+	RadioDevice::clearEndEvent();
+	RadioDevice::clearReceiveInProgressEvent();
+	RadioDevice::clearDisabledEvent();
+	RadioDevice::enableInterruptForAddressEvent();
+	RadioDevice::enableInterruptForEndEvent();
+	RadioDevice::enableInterruptForDisabledEvent();
+}
+
+void disableInterrupts() {
+	RadioDevice::disableInterruptForAddressEvent();
+	RadioDevice::disableInterruptForEndEvent();
+	RadioDevice::disableInterruptForDisabledEvent();
+}
+
+void startChain() {
+	armedSequence = sentSequence;
+	RadioDevice::configurePacketAddress(queue[indexOf(armedSequence)]);
+	RadioDevice::setShortcuts(RadioShortcutProfile::TransmitBurst);
+	_isBusy = true;
+	RadioDevice::startTXTask();
+}
+
+}  // namespace
+
+
+
+bool BurstTransmitter::enqueue(const RadioBufferPointer buffer) {
+	if (isFull()) {
+		return false;
+	}
+	queue[indexOf(enqueuedSequence)] = buffer;
+	// Hand over, after buffer pointer written
+	enqueuedSequence = enqueuedSequence + 1;
+	return true;
+}
+
+unsigned int BurstTransmitter::queuedCount() { return enqueuedSequence - sentSequence; }
+bool BurstTransmitter::isFull() { return queuedCount() == MaxQueueCount; }
+
+
+void BurstTransmitter::start() {
+	assert(!_isBusy);
+	assert(queuedCount() > 0);
+
+	enableInterrupts();
+	startChain();
+}
+
+bool BurstTransmitter::isBusy() { return _isBusy; }
+
+unsigned int BurstTransmitter::sentCount() { return sentSequence; }
+
+
+
+void BurstTransmitter::radioISR() {
+	// Reads and clears
+	if (RadioDevice::isReceiveInProgressEvent()) {
+		onAddressEvent();
+	}
+	if (RadioDevice::isEndEvent()) {
+		RadioDevice::clearEndEvent();
+		onEndEvent();
+	}
+	if (RadioDevice::isDisabledEventSet()) {
+		RadioDevice::clearDisabledEvent();
+		onDisabledEvent();
+	}
+}
+
+
+/*
+ * Packet armedSequence is latched.
+ */
+void BurstTransmitter::onAddressEvent() {
+	unsigned int nextSequence = armedSequence + 1;
+
+	if (nextSequence != enqueuedSequence) {
+		RadioDevice::configureNextPacketAddress(queue[indexOf(nextSequence)]);
+		armedSequence = nextSequence;
+	}
+	else {
+		// Last packet: stop at DISABLED
+		RadioDevice::clearTurnaroundShortcuts();
+		if (RadioDevice::isTransmitRampUpState()) {
+			// ISR late: DISABLED->TXEN already ramping up to send the last buffer again
+			RadioDevice::startDisablingTask();
+		}
+	}
+}
+
+/*
+ * An END past armedSequence is the last buffer sent again (ISR later than the turnaround), not a queued packet.
+ */
+void BurstTransmitter::onEndEvent() {
+	if (armedSequence - sentSequence < BurstTransmitter::MaxQueueCount) {
+		// Hand buffer back to app
+		sentSequence = sentSequence + 1;
+	}
+}
+
+/*
+ * DISABLED between chained packets is also an event: only the last one (shortcut cleared) ends the burst.
+ * A packet queued after the last ADDRESS starts a new chain.
+ */
+void BurstTransmitter::onDisabledEvent() {
+	if (!RadioDevice::isDisabledState()) {
+		// Shortcut already ramping up the next packet
+		return;
+	}
+
+	if (queuedCount() > 0) {
+		startChain();
+	}
+	else {
+		_isBusy = false;
+		disableInterrupts();
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+	}
+}
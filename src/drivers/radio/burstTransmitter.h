@@ -0,0 +1,65 @@
+#pragma once
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Back-to-back transmit of queued packets.
+ *
+ * Shortcuts END->DISABLE and DISABLED->TXEN chain packets in hardware (RadioShortcutProfile::TransmitBurst):
+ * spacing between packets is TX disable plus ramp up (about 45 uSec with fast ramp up), no ISR in the path.
+ * The ISR only keeps PACKETPTR one packet ahead:
+ * - on ADDRESS (current packet latched), point PACKETPTR at the next queued packet,
+ *   or if none, clear DISABLED->TXEN so the chain stops after this packet
+ * - on END, the sent packet's buffer goes back to the app
+ * - on DISABLED (chain stopped), restart if packets were queued meanwhile
+ *
+ * The chain is stopped from ADDRESS, not from END, since END to DISABLED is only the TX disable time,
+ * too short to count on ISR latency.
+ *
+ * The app queues buffers (in Data RAM, in configured packet format) and must not write a buffer until it is sent.
+ * Receivers must be back in RX within the spacing, e.g. using ContinuousReceiver.
+ *
+ * Singleton, all static class methods.
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler.
+ */
+class BurstTransmitter {
+public:
+	/*
+	 * Must be power of two, queue index is a free running sequence modulo count.
+	 */
+	static const unsigned int MaxQueueCount = 8;
+
+	/*
+	 * Returns false if queue full.
+	 * May be called while a burst is going out: the packet joins the burst if queued before the last packet's ADDRESS.
+	 */
+	static bool enqueue(const RadioBufferPointer buffer);
+	// Queued and not yet sent, including the packet on-air
+	static unsigned int queuedCount();
+	static bool isFull();
+
+	/*
+	 * Send all queued packets.
+	 * Requires radio powered on, configured, DISABLED, and at least one packet queued.
+	 */
+	static void start();
+	static bool isBusy();
+
+	/*
+	 * Count of packets sent (END) since reset; the app compares to its own count of enqueued packets.
+	 */
+	static unsigned int sentCount();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 * Handles ADDRESS before END.  When the ISR is late, both may be set
+	 * (ADDRESS and END of one packet, or END of one and ADDRESS of the next): either order arms the right buffer.
+	 * ISR latency must stay below END to START of the next packet (TX disable plus ramp up),
+	 * else the next START latches the previous buffer and sends it again.
+	 */
+	static void radioISR();
+	static void onAddressEvent();
+	static void onEndEvent();
+	static void onDisabledEvent();
+};
@@ -0,0 +1,166 @@
+#include <cassert>
+
+#include "channelScanner.h"
+#include "radio.h"
+
+
+namespace {
+
+ChannelScanner::ChannelQuality results[ChannelScanner::MaxChannelCount];
+unsigned int channelCount = 0;
+unsigned int samplesPerChannel = 1;
+
+volatile unsigned int channelIndex = 0;
+unsigned int sampleIndex = 0;
+volatile bool _isDone = true;
+bool isRanked = false;
+
+// Whole register: MAP (nrf52) as well as frequency
+uint32_t savedFrequency = 0;
+// Address match is off while scanning
+uint8_t savedRXAddresses = 0;
+
+
+void startChannel() {
+	RadioDevice::configureFixedFrequency(results[channelIndex].frequencyIndex);
+	sampleIndex = 0;
+	RadioDevice::startRXTask();
+}
+
+void enableInterrupts() {
+	RadioDevice::clearReadyEvent();
+	RadioDevice::clearRSSISampleDoneEvent();
+	RadioDevice::clearDisabledEvent();
+	RadioDevice::enableInterruptForReadyEvent();
+	RadioDevice::enableInterruptForRSSISampleDoneEvent();
+	RadioDevice::enableInterruptForDisabledEvent();
+}
+
+void disableInterrupts() {
+	RadioDevice::disableInterruptForReadyEvent();
+	RadioDevice::disableInterruptForRSSISampleDoneEvent();
+	RadioDevice::disableInterruptForDisabledEvent();
+}
+
+/*
+ * Insertion sort: small table, done once per scan.
+ */
+void rank() {
+	for (unsigned int i = 1; i < channelCount; i++) {
+		ChannelScanner::ChannelQuality item = results[i];
+		unsigned int j = i;
+		while (j > 0 and results[j - 1].strongestSample < item.strongestSample) {
+			results[j] = results[j - 1];
+			j--;
+		}
+		results[j] = item;
+	}
+}
+
+}  // namespace
+
+
+
+void ChannelScanner::configure(const uint8_t frequencyIndices[], const unsigned int count, const unsigned int aSamplesPerChannel) {
+	assert(_isDone);
+	assert(count >= 1 and count <= MaxChannelCount);
+	assert(aSamplesPerChannel >= 1);
+
+	for (unsigned int i = 0; i < count; i++) {
+		assert(frequencyIndices[i] <= 100);
+		results[i].frequencyIndex = frequencyIndices[i];
+		results[i].strongestSample = 127;
+	}
+	channelCount = count;
+	samplesPerChannel = aSamplesPerChannel;
+}
+
+
+void ChannelScanner::start() {
+	assert(channelCount > 0);
+	assert(RadioDevice::isDisabledState());
+
+	for (unsigned int i = 0; i < channelCount; i++) {
+		results[i].strongestSample = 127;
+	}
+	savedFrequency = RadioDevice::frequency();
+	savedRXAddresses = RadioDevice::receiveLogicalAddresses();
+	channelIndex = 0;
+	_isDone = false;
+	isRanked = false;
+
+	// RX (START at READY) for valid RSSI, but no address enabled: nothing received into PACKETPTR
+	RadioDevice::configureRXLogicalAddresses(0);
+	RadioDevice::setShortcuts(RadioShortcutProfile::SampleSignal);
+	enableInterrupts();
+	startChannel();
+}
+
+bool ChannelScanner::isDone() { return _isDone; }
+
+
+
+void ChannelScanner::radioISR() {
+	if (RadioDevice::isReadyEvent()) {
+		RadioDevice::clearReadyEvent();
+		onReadyEvent();
+	}
+	if (RadioDevice::isRSSISampleDone()) {
+		RadioDevice::clearRSSISampleDoneEvent();
+		onRSSISampleDoneEvent();
+	}
+	if (RadioDevice::isDisabledEventSet()) {
+		RadioDevice::clearDisabledEvent();
+		onDisabledEvent();
+	}
+}
+
+
+// START already followed READY (shortcut): in RX
+void ChannelScanner::onReadyEvent() {
+	RadioDevice::startRSSISample();
+}
+
+void ChannelScanner::onRSSISampleDoneEvent() {
+	unsigned int sample = RadioDevice::receivedSignalStrength();
+	if (sample < results[channelIndex].strongestSample)
+		results[channelIndex].strongestSample = (uint8_t) sample;
+
+	sampleIndex++;
+	if (sampleIndex < samplesPerChannel)
+		RadioDevice::startRSSISample();
+	else
+		RadioDevice::startDisablingTask();
+}
+
+/*
+ * FREQUENCY may only change while DISABLED.
+ */
+void ChannelScanner::onDisabledEvent() {
+	channelIndex = channelIndex + 1;
+	if (channelIndex < channelCount) {
+		startChannel();
+	}
+	else {
+		disableInterrupts();
+		RadioDevice::restoreFrequency(savedFrequency);
+		RadioDevice::configureRXLogicalAddresses(savedRXAddresses);
+		RadioDevice::setShortcutsAvoidSomeEvents();
+		_isDone = true;
+	}
+}
+
+
+
+const ChannelScanner::ChannelQuality* ChannelScanner::rankedResults() {
+	assert(_isDone);
+	if (!isRanked) {
+		rank();
+		isRanked = true;
+	}
+	return results;
+}
+
+unsigned int ChannelScanner::resultCount() { return channelCount; }
+
+uint8_t ChannelScanner::quietestChannel() { return rankedResults()[0].frequencyIndex; }
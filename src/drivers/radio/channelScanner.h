@@ -0,0 +1,55 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * Energy detect scan across a list of channels (FREQUENCY indices.)
+ *
+ * For each channel: set FREQUENCY, ramp up and START RX (RSSI is valid only in RX, not RXIDLE),
+ * take RSSI samples, disable, next channel.
+ * No logical address is enabled meanwhile (RXADDRESSES zero), so nothing is received into memory.
+ * Driven by radio interrupts (READY, RSSIEND, DISABLED), not a cpu polling loop:
+ * the cpu may sleep (MCU::sleepUntilEvent) until isDone().
+ * Dwell is samplesPerChannel RSSI samples after ramp up, one sample being the shortest legal dwell.
+ *
+ * Result is a table of channels ranked quietest first.
+ *
+ * Singleton, all static class methods.
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler.
+ * Restores FREQUENCY, RXADDRESSES and shortcuts (SinglePacket) when done.
+ */
+class ChannelScanner {
+public:
+	// FREQUENCY 0..100
+	static const unsigned int MaxChannelCount = 101;
+
+	struct ChannelQuality {
+		uint8_t frequencyIndex;
+		// -dBm of strongest sample, as receivedSignalStrength(): larger is quieter
+		uint8_t strongestSample;
+	};
+
+	static void configure(const uint8_t frequencyIndices[], const unsigned int count, const unsigned int samplesPerChannel);
+
+	/*
+	 * Radio must be configured (mode, fast rampup) and DISABLED.
+	 */
+	static void start();
+	static bool isDone();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 */
+	static void radioISR();
+	static void onReadyEvent();
+	static void onRSSISampleDoneEvent();
+	static void onDisabledEvent();
+
+	/*
+	 * Valid when done.  Sorts in place on first call after scan.
+	 */
+	static const ChannelQuality* rankedResults();
+	static unsigned int resultCount();
+	static uint8_t quietestChannel();
+};
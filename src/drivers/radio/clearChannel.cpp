@@ -0,0 +1,143 @@
+#include <cassert>
+
+#include "clearChannel.h"
+#include "radio.h"
+
+
+namespace {
+
+// RSSISAMPLE is positive, -dBm.  Clear if every sample is greater (i.e. weaker signal.)
+unsigned int thresholdSample = 85;
+unsigned int dwell = 1;
+
+uint32_t backoffSlotTicks = 1;
+unsigned int backoffMaxExponent = 5;
+unsigned int attempts = 0;
+uint32_t randomState = 1;
+
+unsigned int busy = 0;
+
+// Address match is off while sampling
+uint8_t savedRXAddresses = 0;
+
+
+/*
+ * xorshift32, state nonzero
+ */
+uint32_t nextRandom() {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+
+/*
+ * To RX: READY_START, so RSSI samples are valid.
+ */
+void rampUpReceiver() {
+	assert(RadioDevice::isDisabledState());
+	savedRXAddresses = RadioDevice::receiveLogicalAddresses();
+	RadioDevice::configureRXLogicalAddresses(0);
+	RadioDevice::setShortcuts(RadioShortcutProfile::SampleSignal);
+	RadioDevice::clearReadyEvent();
+	RadioDevice::startRXTask();
+	while (!RadioDevice::isReadyEvent()) {}
+	RadioDevice::clearReadyEvent();
+}
+
+void restoreRXAddresses() {
+	RadioDevice::configureRXLogicalAddresses(savedRXAddresses);
+}
+
+/*
+ * Smallest sample is strongest signal.
+ */
+unsigned int strongestSample() {
+	unsigned int strongest = 127;
+	for (unsigned int i = 0; i < dwell; i++) {
+		unsigned int sample = RadioDevice::sampleSignalStrength();
+		if (sample < strongest)  strongest = sample;
+	}
+	return strongest;
+}
+
+void disableAndWait() {
+	RadioDevice::startDisablingTask();
+	while (!RadioDevice::isDisabledState()) {}
+	RadioDevice::clearDisabledEvent();
+}
+
+}  // namespace
+
+
+
+void ClearChannelTransmitter::configure(const int8_t thresholdDBm, const unsigned int dwellSamples) {
+	assert(thresholdDBm < 0);
+	assert(dwellSamples >= 1);
+	thresholdSample = -thresholdDBm;
+	dwell = dwellSamples;
+}
+
+void ClearChannelTransmitter::configureBackoff(const uint32_t slotTicks, const unsigned int maxExponent, const uint32_t seed) {
+	assert(slotTicks >= 1);
+	assert(maxExponent < 16);
+	backoffSlotTicks = slotTicks;
+	backoffMaxExponent = maxExponent;
+	randomState = (seed != 0) ? seed : 1;
+	attempts = 0;
+}
+
+
+unsigned int ClearChannelTransmitter::assessChannel() {
+	rampUpReceiver();
+	unsigned int result = strongestSample();
+	disableAndWait();
+	restoreRXAddresses();
+	// Restore usual shortcuts
+	RadioDevice::setShortcutsAvoidSomeEvents();
+	return result;
+}
+
+
+bool ClearChannelTransmitter::transmitIfClear(RadioBufferPointer packet) {
+	RadioDevice::configurePacketAddress(packet);
+	rampUpReceiver();
+
+	if (strongestSample() > thresholdSample) {
+		/*
+		 * Clear.
+		 * READY_START stays set: TX READY will START.
+		 * DISABLE then DISABLED_TXEN: turnaround in hardware.
+		 * No address matched in RX meanwhile, so no END: END_DISABLE is harmless.
+		 */
+		RadioDevice::setShortcuts(RadioShortcutProfile::ReceiveThenTransmit);
+		RadioDevice::clearDisabledEvent();
+		RadioDevice::startDisablingTask();
+		// RX disable is immediate; TXEN follows DISABLED
+		while (!RadioDevice::isDisabledEventSet()) {}
+		RadioDevice::clearDisabledEvent();
+		RadioDevice::clearTurnaroundShortcuts();
+		// RXADDRESSES is not used in TX
+		restoreRXAddresses();
+		attempts = 0;
+		return true;
+	}
+	else {
+		disableAndWait();
+		restoreRXAddresses();
+		RadioDevice::setShortcutsAvoidSomeEvents();
+		busy++;
+		return false;
+	}
+}
+
+
+uint32_t ClearChannelTransmitter::nextBackoffTicks() {
+	unsigned int exponent = (attempts < backoffMaxExponent) ? attempts : backoffMaxExponent;
+	attempts++;
+	uint32_t window = backoffSlotTicks << exponent;
+	return nextRandom() % window;
+}
+
+unsigned int ClearChannelTransmitter::busyCount() { return busy; }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Listen-before-talk: clear channel assessment by RSSI before transmit.
+ *
+ * Ramp up and START RX (RSSI is valid only in RX, not RXIDLE) with no logical address enabled
+ * (RXADDRESSES zero, restored after), so no packet is received over the outgoing packet at PACKETPTR,
+ * sample RSSI dwellSamples times, and only if every sample is below threshold,
+ * turn around to TX in hardware (shortcut DISABLED_TXEN.)
+ * Else radio is DISABLED and caller should back off (see nextBackoffTicks.)
+ *
+ * A short RSSI sample costs far less energy than a retransmission after a collision.
+ *
+ * Blocking: spins for RX ramp up and samples (see configureFastRampUp.)
+ * Singleton, all static class methods.
+ */
+class ClearChannelTransmitter {
+public:
+	/*
+	 * thresholdDBm: channel clear if signal weaker, e.g. -85
+	 * dwellSamples: count of RSSI samples, at least one
+	 */
+	static void configure(const int8_t thresholdDBm, const unsigned int dwellSamples);
+
+	/*
+	 * Binary exponential backoff: random in [0, slotTicks * 2^min(attempts, maxExponent))
+	 * Seed is any nonzero value distinct per device, e.g. from SystemProperties::deviceID()
+	 */
+	static void configureBackoff(const uint32_t slotTicks, const unsigned int maxExponent, const uint32_t seed);
+
+	/*
+	 * Radio must be configured and DISABLED.
+	 * Returns true if channel clear and transmit started (radio is in TX or ramping up.)
+	 * When true, shortcuts are SinglePacket: packet done is DISABLED as usual.
+	 * Returns false if busy: radio is DISABLED.
+	 */
+	static bool transmitIfClear(RadioBufferPointer packet);
+
+	/*
+	 * Sample only, leaves radio DISABLED.  Strongest sample in -dBm units as receivedSignalStrength()
+	 */
+	static unsigned int assessChannel();
+
+	/*
+	 * Ticks caller should wait before next attempt.  Counts an attempt.
+	 */
+	static uint32_t nextBackoffTicks();
+
+	static unsigned int busyCount();
+};
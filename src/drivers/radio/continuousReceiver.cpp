@@ -0,0 +1,217 @@
+#include <cassert>
+
+#include "continuousReceiver.h"
+#include "radio.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Single producer (ISR) and single consumer (app.)
+ * Each side writes only its own sequence number, so no critical sections needed.
+ * Sequence numbers are free running (wrap at 2^32), buffer index is sequence modulo count,
+ * which is continuous across the wrap since count is power of two.
+ *
+ * Buffers in [consumedSequence, receivingSequence) are completed (owned by app.)
+ * Buffer receivingSequence is owned by radio.
+ *
+ * END->START latches PACKETPTR, so the next buffer must be armed before END.
+ * When it was not (no free buffer at ADDRESS, or ADDRESS handled late), START again at END
+ * once a next buffer is armed, instead of receiving the next packet into the buffer just handed over.
+ */
+
+namespace {
+
+RadioBufferPointer buffers[ContinuousReceiver::MaxBufferCount];
+bool bufferCRCValid[ContinuousReceiver::MaxBufferCount];
+uint8_t bufferLogicalAddress[ContinuousReceiver::MaxBufferCount];
+unsigned int bufferCount = 0;
+
+volatile unsigned int receivingSequence = 0;
+volatile unsigned int consumedSequence = 0;
+
+// Whether PACKETPTR was advanced for the packet in progress
+bool isNextBufferArmed = false;
+// Whether ADDRESS of the packet in progress was handled (its END not yet)
+bool isAddressHandled = false;
+// RXMATCH of the packet in progress, latched at its ADDRESS
+uint8_t addressLogicalAddress = 0;
+
+volatile unsigned int overruns = 0;
+
+bool _isStarted = false;
+
+
+unsigned int indexOf(unsigned int sequence) {
+	return sequence & (bufferCount - 1);
+}
+
+/*
+ * If next buffer is still held by app, leave PACKETPTR alone.
+ */
+void armNextBuffer() {
+	unsigned int nextSequence = receivingSequence + 1;
+
+	if (nextSequence - consumedSequence < bufferCount) {
+		RadioDevice::configureNextPacketAddress(buffers[indexOf(nextSequence)]);
+		isNextBufferArmed = true;
+	}
+	else {
+		isNextBufferArmed = false;
+	}
+}
+
+}  // namespace
+
+
+
+void ContinuousReceiver::configureBuffers(const RadioBufferPointer aBuffers[], unsigned int count) {
+	assert(!_isStarted);
+	assert(count >= 2 && count <= MaxBufferCount);
+	assert((count & (count - 1)) == 0);	// power of two
+
+	for (unsigned int i = 0; i < count; i++) {
+		buffers[i] = aBuffers[i];
+		bufferCRCValid[i] = false;
+		bufferLogicalAddress[i] = 0;
+	}
+	bufferCount = count;
+	receivingSequence = 0;
+	consumedSequence = 0;
+	overruns = 0;
+}
+
+
+void ContinuousReceiver::start() {
+	assert(bufferCount != 0);
+	assert(!_isStarted);
+
+	isNextBufferArmed = false;
+	isAddressHandled = false;
+	addressLogicalAddress = 0;
+	RadioDevice::configurePacketAddress(buffers[indexOf(receivingSequence)]);
+	RadioDevice::setShortcutsContinuousReceive();
+
+	RadioDevice::clearEndEvent();
+	RadioDevice::clearReceiveInProgressEvent();
+	RadioDevice::enableInterruptForEndEvent();
+	RadioDevice::enableInterruptForAddressEvent();
+
+	_isStarted = true;
+	RadioDevice::startRXTask();
+}
+
+
+void ContinuousReceiver::stop() {
+	RadioDevice::disableInterruptForAddressEvent();
+	RadioDevice::disableInterruptForEndEvent();
+
+	// DISABLE task in RX: no END for a packet in progress, it is lost
+	RadioDevice::startDisablingTask();
+	while (!RadioDevice::isDisabledState()) {}
+
+	RadioDevice::clearEndEvent();
+	RadioDevice::clearReceiveInProgressEvent();
+	RadioDevice::setShortcutsAvoidSomeEvents();
+	_isStarted = false;
+}
+
+bool ContinuousReceiver::isStarted() { return _isStarted; }
+
+
+
+void ContinuousReceiver::radioISR() {
+	// END of the packet whose ADDRESS an earlier ISR handled: before the next packet's ADDRESS
+	if (isAddressHandled && RadioDevice::isEndEvent()) {
+		RadioDevice::clearEndEvent();
+		onEndEvent();
+	}
+	// Reads and clears
+	if (RadioDevice::isReceiveInProgressEvent()) {
+		onAddressEvent();
+	}
+	// END of the packet whose ADDRESS was just handled (ISR late): END->START latched PACKETPTR before it was advanced
+	if (RadioDevice::isEndEvent()) {
+		RadioDevice::clearEndEvent();
+		isNextBufferArmed = false;
+		onEndEvent();
+	}
+}
+
+
+/*
+ * Current packet is latched, so PACKETPTR can point to next buffer.
+ * If next buffer is still held by app, leave PACKETPTR alone:
+ * shortcut END->START will receive next packet into the same buffer (unless onEndEvent() finds one free.)
+ *
+ * ADDRESS of the next packet before END of this one was handled (separately dispatched handlers, late):
+ * leave arming to onEndEvent().
+ */
+void ContinuousReceiver::onAddressEvent() {
+	if (isAddressHandled) {
+		return;
+	}
+	isAddressHandled = true;
+	addressLogicalAddress = RadioDevice::receivedLogicalAddress();
+	armNextBuffer();
+}
+
+/*
+ * Shortcut END->START has already restarted RX (into next buffer, if armed.)
+ * CRCSTATUS is valid for the just ended packet until the next END.
+ * RXMATCH is not: an END handled late (after the next packet's ADDRESS) would read the next packet's,
+ * so use the one latched at this packet's ADDRESS.
+ * If not armed, but a buffer is free now, arm it and START again: a packet begun since END is lost.
+ */
+void ContinuousReceiver::onEndEvent() {
+	const bool isCRCValid = RadioDevice::isCRCValid();
+	const uint8_t logicalAddress = addressLogicalAddress;
+
+	isAddressHandled = false;
+	if (!isNextBufferArmed) {
+		armNextBuffer();
+		if (isNextBufferArmed) {
+			RadioDevice::restartRXTask();
+		}
+	}
+
+	if (isNextBufferArmed) {
+		bufferCRCValid[indexOf(receivingSequence)] = isCRCValid;
+		bufferLogicalAddress[indexOf(receivingSequence)] = logicalAddress;
+		// Hand over
+		receivingSequence = receivingSequence + 1;
+		isNextBufferArmed = false;
+	}
+	else {
+		overruns = overruns + 1;
+	}
+}
+
+
+
+bool ContinuousReceiver::isCompletedBuffer() {
+	return consumedSequence != receivingSequence;
+}
+
+RadioBufferPointer ContinuousReceiver::completedBuffer() {
+	assert(isCompletedBuffer());
+	return buffers[indexOf(consumedSequence)];
+}
+
+bool ContinuousReceiver::isCompletedBufferCRCValid() {
+	assert(isCompletedBuffer());
+	return bufferCRCValid[indexOf(consumedSequence)];
+}
+
+uint8_t ContinuousReceiver::completedBufferLogicalAddress() {
+	assert(isCompletedBuffer());
+	return bufferLogicalAddress[indexOf(consumedSequence)];
+}
+
+void ContinuousReceiver::releaseCompletedBuffer() {
+	assert(isCompletedBuffer());
+	// Ownership back to radio, ISR may now arm this buffer
+	consumedSequence = consumedSequence + 1;
+}
+
+unsigned int ContinuousReceiver::overrunCount() { return overruns; }
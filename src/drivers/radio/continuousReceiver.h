@@ -0,0 +1,73 @@
+#pragma once
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Continuous (ping-pong) receive.
+ *
+ * Radio stays in RX between packets (shortcut END->START instead of END->DISABLE.)
+ * Packets go into a ring of buffers, PACKETPTR is swapped in the ISR:
+ * - on ADDRESS (current packet latched), point PACKETPTR at next free buffer
+ * - on END, hand the filled buffer over to the app
+ *
+ * The app (main loop) takes completed buffers in order, and must release each when done.
+ * If the app holds all other buffers, the current buffer is reused and the packet is counted as an overrun.
+ * RX is restarted at END (losing any packet begun since) when the next buffer could not be armed in time.
+ *
+ * Singleton, all static class methods.
+ *
+ * Not compatible with setShortcutsAvoidSomeEvents() while started.
+ * !!! Caller must also enable the radio IRQ in the NVIC, and call radioISR() from RADIO_IRQHandler.
+ */
+class ContinuousReceiver {
+public:
+	/*
+	 * Must be power of two, buffer index is a free running sequence modulo count.
+	 */
+	static const unsigned int MaxBufferCount = 4;
+
+	/*
+	 * Buffers must be in Data RAM and large enough for configured packet format.
+	 * Count must be power of two and at least 2.
+	 */
+	static void configureBuffers(const RadioBufferPointer buffers[], unsigned int count);
+
+	/*
+	 * Requires radio powered on, configured, and DISABLED.
+	 */
+	static void start();
+
+	/*
+	 * Radio to DISABLED, shortcuts to setShortcutsAvoidSomeEvents().
+	 * Completed buffers not yet taken remain available.
+	 */
+	static void stop();
+	static bool isStarted();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 * When the ISR is late, ADDRESS and END may both be set:
+	 * - END of one packet and ADDRESS of the next: END first
+	 * - ADDRESS and END of the same packet: ADDRESS first, then END restarts RX into the next buffer
+	 * so a packet received into a free buffer is never counted as an overrun.
+	 * Handlers dispatched separately (RadioEventDispatcher) cannot tell the second case:
+	 * there, ISR latency must stay below the shortest packet.
+	 */
+	static void radioISR();
+	static void onAddressEvent();
+	static void onEndEvent();
+
+	// App (main loop) side
+	static bool isCompletedBuffer();
+	static RadioBufferPointer completedBuffer();
+	static bool isCompletedBufferCRCValid();
+	// RXMATCH of the packet in buffer (latched at its ADDRESS), see LogicalAddressDispatcher
+	static uint8_t completedBufferLogicalAddress();
+	static void releaseCompletedBuffer();
+
+	/*
+	 * Count of packets received but not handed over since no free buffer.
+	 */
+	static unsigned int overrunCount();
+};
@@ -0,0 +1,97 @@
+#include <cassert>
+
+#include "deviceAddress.h"
+#include "radio.h"
+#include "../uniqueID.h"
+
+
+const NetworkAddress DeviceAddressing::BroadcastAddress = { 0xE7E7E7E7, 0xE7 };
+
+namespace {
+
+/*
+ * Finalizer of MurmurHash3: every bit of deviceID affects every bit of result.
+ */
+uint64_t mix(uint64_t value) {
+	value ^= value >> 33;
+	value *= 0xFF51AFD7ED558CCDull;
+	value ^= value >> 33;
+	value *= 0xC4CEB9FE1A85EC53ull;
+	value ^= value >> 33;
+	return value;
+}
+
+bool isOutlawedByte(uint8_t value) {
+	return value == 0x00 || value == 0xFF || value == 0x55 || value == 0xAA;
+}
+
+unsigned int bitTransitions(uint64_t bits, unsigned int width) {
+	uint64_t changes = (bits ^ (bits >> 1)) & ((1ull << (width - 1)) - 1);
+	return __builtin_popcountll(changes);
+}
+
+}  // namespace
+
+
+
+bool DeviceAddressing::isValid(const NetworkAddress& address) {
+	for (unsigned int i = 0; i < 4; i++) {
+		if (isOutlawedByte((uint8_t) (address.base >> (8 * i))))
+			return false;
+	}
+	if (isOutlawedByte(address.prefix))
+		return false;
+
+	uint64_t bits = ((uint64_t) address.base << 8) | address.prefix;
+	return bitTransitions(bits, 40) >= MinBitTransitions
+			&& !(address == BroadcastAddress);
+}
+
+
+/*
+ * Rehash until valid.  About half of hashes are valid, so loop is short.
+ */
+NetworkAddress DeviceAddressing::addressForDevice(uint64_t deviceID) {
+	uint64_t hash = deviceID;
+	NetworkAddress result;
+
+	do {
+		hash = mix(hash + 1);
+		result.base = (uint32_t) hash;
+		result.prefix = (uint8_t) (hash >> 32);
+	} while (!isValid(result));
+	return result;
+}
+
+
+
+void DeviceAddressing::configure(uint64_t ownDeviceID) {
+	assert(RadioDevice::isDisabledState());
+
+	const NetworkAddress own = addressForDevice(ownDeviceID);
+	RadioDevice::configureBaseAddress(0, own.base);
+	RadioDevice::configurePrefix(UnicastLogicalAddress, own.prefix);
+	RadioDevice::configurePrefix(BroadcastLogicalAddress, BroadcastAddress.prefix);
+	configureTXBroadcast();
+	RadioDevice::configureRXLogicalAddresses((1 << UnicastLogicalAddress) | (1 << BroadcastLogicalAddress));
+}
+
+void DeviceAddressing::configure() { configure(SystemProperties::deviceID()); }
+
+
+void DeviceAddressing::configureTXUnicast(uint64_t peerDeviceID) {
+	const NetworkAddress peer = addressForDevice(peerDeviceID);
+	RadioDevice::configureBaseAddress(1, peer.base);
+	RadioDevice::configurePrefix(PeerLogicalAddress, peer.prefix);
+	RadioDevice::configureTXLogicalAddress(PeerLogicalAddress);
+}
+
+void DeviceAddressing::configureTXBroadcast() {
+	RadioDevice::configureBaseAddress(1, BroadcastAddress.base);
+	RadioDevice::configureTXLogicalAddress(BroadcastLogicalAddress);
+}
+
+
+bool DeviceAddressing::isReceivedUnicast() {
+	return RadioDevice::receivedLogicalAddress() == UnicastLogicalAddress;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * On-air address: base (BASEn) and prefix (byte of PREFIXn.)
+ * Assumes BALEN 4 (AddressLength 5) but valid for shorter BALEN: every base byte is checked.
+ */
+struct NetworkAddress {
+	uint32_t base;
+	uint8_t prefix;
+
+	bool operator==(const NetworkAddress& other) const { return base == other.base && prefix == other.prefix; }
+};
+
+
+/*
+ * Per-device unicast addressing, for hardware filtering of unicast traffic.
+ *
+ * Each node's unicast address is derived from its deviceID (FICR), so no provisioning:
+ * a hash of the deviceID, rehashed until valid (see isValid.)
+ * Any node can compute any peer's address from the peer's deviceID.
+ *
+ * Logical addresses (pool) used:
+ * - 0: own unicast (BASE0, AP0), RX.  Never changed after configure.
+ * - 1: broadcast (BASE1, AP1), RX.  Same on all nodes: the 0xE7 pool address of configureNetworkAddressPool().
+ * - 2: peer unicast (BASE1, AP2), TX only.
+ *
+ * Unicast to another node uses BASE1 while transmitting, so broadcast is not received meanwhile;
+ * call configureTXBroadcast() after the unicast (and its ack, if any) to restore it.
+ * An ack to us is addressed to our own unicast address, on BASE0, which is untouched.
+ *
+ * Address matcher (RXADDRESSES 0 and 1) drops unicast for other nodes without waking the cpu.
+ * Hash collisions (two devices, same 40-bit address) are possible but rare;
+ * protocols that care still carry the deviceID in the payload.
+ *
+ * Singleton, all static class methods.
+ */
+class DeviceAddressing {
+public:
+	static const uint8_t UnicastLogicalAddress = 0;
+	static const uint8_t BroadcastLogicalAddress = 1;
+	static const uint8_t PeerLogicalAddress = 2;
+
+	static const NetworkAddress BroadcastAddress;
+
+	/*
+	 * Valid: no byte of base, nor prefix, is 0x00, 0xFF, 0x55, 0xAA (would extend or mimic preamble),
+	 * at least MinBitTransitions transitions over the 40 bits, and not the broadcast address.
+	 */
+	static const unsigned int MinBitTransitions = 12;
+	static bool isValid(const NetworkAddress& address);
+
+	static NetworkAddress addressForDevice(uint64_t deviceID);
+
+	/*
+	 * Radio powered on and DISABLED.
+	 * RX on own unicast and broadcast, TX to broadcast.
+	 */
+	static void configure(uint64_t ownDeviceID);
+	// Own deviceID from SystemProperties
+	static void configure();
+
+	static void configureTXUnicast(uint64_t peerDeviceID);
+	static void configureTXBroadcast();
+
+	/*
+	 * Of the most recently received packet.
+	 */
+	static bool isReceivedUnicast();
+};
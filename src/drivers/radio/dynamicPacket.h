@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cassert>
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Dynamic (variable length) packet format.
+ *
+ * LENGTH field is transmitted, so on-air payload is only as long as LENGTH says (not STATLEN.)
+ *
+ * Memory structure (what PACKETPTR points to):
+ * S0 (0 or 1 byte), LENGTH (1 byte), S1 (0 or 1 byte), PAYLOAD (LENGTH bytes)
+ * On-air, S0 is S0 bytes, LENGTH is lengthBits, S1 is s1Bits.
+ *
+ * Limited to fields that fit one byte in RAM (lengthBits <= 8, s1Bits <= 8),
+ * so memory layout does not depend on S1INCL or chip family.
+ */
+struct DynamicPacketFormat {
+	uint8_t s0Bytes;	// 0 or 1
+	uint8_t lengthBits;	// 1..8
+	uint8_t s1Bits;		// 0..8
+
+	uint8_t lengthOffset() const { return s0Bytes; }
+	uint8_t s1Offset() const { return s0Bytes + 1; }
+	uint8_t headerLength() const { return s0Bytes + 1 + (s1Bits > 0 ? 1 : 0); }
+
+	/*
+	 * Largest value LENGTH field can carry on-air.
+	 */
+	uint8_t maxLength() const { return (uint8_t) ((1u << lengthBits) - 1); }
+};
+
+
+
+/*
+ * View on a packet buffer in dynamic format.
+ * Does not own the buffer, does not copy.
+ *
+ * Reads and writes the in-RAM header the radio reads (TX) or writes (RX.)
+ */
+class DynamicPacket {
+	const RadioBufferPointer buffer;
+	const DynamicPacketFormat format;
+
+public:
+	DynamicPacket(RadioBufferPointer aBuffer, const DynamicPacketFormat aFormat):
+		buffer(aBuffer),
+		format(aFormat) {}
+
+	uint8_t s0() const {
+		assert(format.s0Bytes == 1);
+		return buffer[0];
+	}
+	void setS0(uint8_t value) const {
+		assert(format.s0Bytes == 1);
+		buffer[0] = value;
+	}
+
+	uint8_t length() const { return buffer[format.lengthOffset()]; }
+	void setLength(uint8_t value) const {
+		assert(value <= format.maxLength());
+		buffer[format.lengthOffset()] = value;
+	}
+
+	uint8_t s1() const {
+		assert(format.s1Bits > 0);
+		return buffer[format.s1Offset()];
+	}
+	void setS1(uint8_t value) const {
+		assert(format.s1Bits > 0);
+		buffer[format.s1Offset()] = value;
+	}
+
+	RadioBufferPointer payload() const { return buffer + format.headerLength(); }
+
+	/*
+	 * Count of bytes of RAM used by packet, header and payload.
+	 */
+	unsigned int bufferLength() const { return format.headerLength() + length(); }
+};
@@ -0,0 +1,115 @@
+#include <cassert>
+
+#include "earlyRejectFilter.h"
+#include "radio.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Bit count is of on-air bits: a LENGTH field of 6 bits counts 6, though it fills a byte in RAM.
+ * Counting to the last bit of the last compared byte: ISR latency is further margin for the DMA write to RAM.
+ */
+
+namespace {
+
+uint8_t matchValue[EarlyRejectFilter::MaxMatchLength];
+uint8_t matchMask[EarlyRejectFilter::MaxMatchLength];
+unsigned int matchLength = 0;
+
+uint32_t bits = 0;
+
+volatile bool _isRejected = false;
+volatile unsigned int _rejectedCount = 0;
+
+
+/*
+ * On-air bits of RAM byte at index, per format.
+ */
+uint32_t onAirBitsOfByte(const DynamicPacketFormat& format, unsigned int index) {
+	if (index < format.s0Bytes) {
+		return 8;
+	}
+	index -= format.s0Bytes;
+	if (format.lengthBits > 0) {
+		if (index == 0) {
+			return format.lengthBits;
+		}
+		index--;
+	}
+	if (format.s1Bits > 0 && index == 0) {
+		return format.s1Bits;
+	}
+	return 8;
+}
+
+bool isMatch(const volatile uint8_t* buffer) {
+	for (unsigned int i = 0; i < matchLength; i++) {
+		if ((buffer[i] & matchMask[i]) != matchValue[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+
+
+void EarlyRejectFilter::configure(const DynamicPacketFormat& format, const uint8_t value[], const uint8_t mask[], unsigned int length) {
+	assert(length > 0 && length <= MaxMatchLength);
+
+	bits = 0;
+	for (unsigned int i = 0; i < length; i++) {
+		matchMask[i] = mask[i];
+		matchValue[i] = value[i] & mask[i];
+		bits += onAirBitsOfByte(format, i);
+	}
+	matchLength = length;
+}
+
+uint32_t EarlyRejectFilter::bitCount() { return bits; }
+
+
+void EarlyRejectFilter::arm() {
+	assert(matchLength > 0);
+	assert(RadioDevice::isDisabledState());
+
+	_isRejected = false;
+	RadioDevice::configureBitCounter(bits);
+	RadioDevice::clearBitCounterMatchEvent();
+	RadioDevice::enableBitCounterShortcut();
+	RadioDevice::enableInterruptForBitCounterMatchEvent();
+}
+
+void EarlyRejectFilter::disarm() {
+	RadioDevice::disableInterruptForBitCounterMatchEvent();
+	RadioDevice::disableBitCounterShortcut();
+}
+
+
+bool EarlyRejectFilter::isRejected() { return _isRejected; }
+unsigned int EarlyRejectFilter::rejectedCount() { return _rejectedCount; }
+
+
+
+void EarlyRejectFilter::radioISR() {
+	if (RadioDevice::isBitCounterMatchEvent()) {
+		RadioDevice::clearBitCounterMatchEvent();
+		onBitCounterMatchEvent();
+	}
+}
+
+/*
+ * PACKETPTR is the buffer latched for this packet, as long as nothing swaps it during RX.
+ */
+void EarlyRejectFilter::onBitCounterMatchEvent() {
+	if (isMatch(RadioDevice::packetAddress())) {
+		_isRejected = false;
+	}
+	else {
+		RadioDevice::startDisablingTask();
+		_isRejected = true;
+		_rejectedCount = _rejectedCount + 1;
+	}
+}
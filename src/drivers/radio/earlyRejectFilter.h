@@ -0,0 +1,57 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "dynamicPacket.h"	// DynamicPacketFormat
+
+
+/*
+ * Early rejection of foreign packets, using the bit counter.
+ *
+ * Bit counter starts at ADDRESS (shortcut ADDRESS->BCSTART) and raises BCMATCH
+ * when the first bytes of the packet (header, and optionally payload) are in RAM.
+ * The BCMATCH handler compares those bytes to a value under a mask, and on mismatch DISABLEs the radio at once,
+ * instead of receiving (and paying RX current for) the rest of a packet not for us.
+ *
+ * A rejected packet ends in DISABLED without END: the app's receive logic sees an empty receive.
+ * Use with SinglePacket shortcuts (or ReceiveWindow); not with ContinuousReceiver (DISABLE would stop it.)
+ *
+ * The bytes compared are as the radio writes them to RAM: S0, LENGTH, S1, then payload.
+ * A LENGTH or S1 of fewer than 8 bits occupies a whole byte in RAM: mask off the bits not on-air.
+ * Packets shorter than the compared bytes never raise BCMATCH and are received whole.
+ *
+ * Singleton, all static class methods.
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler,
+ * or register onBitCounterMatchEvent() with RadioEventDispatcher (RadioEvent::BitCounterMatch.)
+ */
+class EarlyRejectFilter {
+public:
+	static const unsigned int MaxMatchLength = 4;
+
+	/*
+	 * Accept a packet when (byte[i] & mask[i]) == value[i] for its first length bytes.
+	 * format is the configured on-air format (see configureDynamicPacketFormat), from which the bit count is derived.
+	 */
+	static void configure(const DynamicPacketFormat& format, const uint8_t value[], const uint8_t mask[], unsigned int length);
+
+	// Bits after ADDRESS until the compared bytes are received
+	static uint32_t bitCount();
+
+	/*
+	 * Radio DISABLED, shortcuts already set (setShortcuts clears the bit counter shortcut.)
+	 */
+	static void arm();
+	static void disarm();
+
+	/*
+	 * Most recent packet that reached BCMATCH was rejected.
+	 */
+	static bool isRejected();
+	static unsigned int rejectedCount();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 */
+	static void radioISR();
+	static void onBitCounterMatchEvent();
+};
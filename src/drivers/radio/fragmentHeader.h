@@ -0,0 +1,51 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Header of fragments and acks, first bytes of the payload (after LENGTH) of a dynamic format packet.
+ * See Fragmenter and Reassembler.
+ *
+ * Fragment: [flags | messageID] [index] [data...]
+ * Ack:      [Ack | messageID] [received mask, 8 bytes, little endian]
+ *
+ * Flags are the top three bits of the first byte, messageID the low five.
+ * Bit i of the received mask is set when fragment i has been received.
+ */
+namespace FragmentHeader {
+
+const uint8_t Ack = 0x80;
+const uint8_t AckRequest = 0x40;	// sender awaits an ack after this fragment
+const uint8_t Last = 0x20;		// fragment is the last of its message
+const uint8_t MessageIDMask = 0x1F;
+const uint8_t FlagsMask = 0xE0;
+
+const unsigned int FragmentHeaderLength = 2;
+const unsigned int AckLength = 1 + 8;
+
+// Bounded by the received mask
+const unsigned int MaxFragmentCount = 64;
+
+
+inline uint64_t maskOfCount(unsigned int count) {
+	return count >= 64 ? ~0ull : (1ull << count) - 1;
+}
+
+inline void writeMask(RadioBufferPointer bytes, uint64_t mask) {
+	for (unsigned int i = 0; i < 8; i++) {
+		bytes[i] = (uint8_t) (mask >> (8 * i));
+	}
+}
+
+inline uint64_t readMask(const RadioBufferPointer bytes) {
+	uint64_t result = 0;
+	for (unsigned int i = 0; i < 8; i++) {
+		result |= (uint64_t) bytes[i] << (8 * i);
+	}
+	return result;
+}
+
+}  // namespace
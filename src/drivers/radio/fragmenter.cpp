@@ -0,0 +1,147 @@
+#include <cassert>
+
+#include "fragmenter.h"
+#include "fragmentHeader.h"
+#include "dynamicPacket.h"
+#include "reassembler.h"	// MaxMessageLength
+
+
+/*
+ * Implementation notes:
+ *
+ * Buffers are used round robin in the order enqueued.
+ * BurstTransmitter's queue is FIFO and no one else enqueues meanwhile,
+ * so while its queue is not full, the next buffer in turn is already sent.
+ *
+ * Masks: bit i is fragment i.
+ */
+
+namespace {
+
+const DynamicPacketFormat Format = { 0, 8, 0 };
+const unsigned int MaxPacketLength = 1 + 255;	// LENGTH, payload
+
+uint8_t buffers[Fragmenter::BufferCount][MaxPacketLength];
+unsigned int nextBuffer = 0;
+
+uint8_t payloadLength = 0;
+
+const uint8_t* message = nullptr;
+uint16_t messageLength = 0;
+uint8_t messageID = 0;
+unsigned int count = 0;
+
+uint64_t ackedMask = 0;
+// Fragments still to be queued this round
+uint64_t roundMask = 0;
+
+unsigned int sentCount = 0;
+
+
+uint64_t unackedMask() { return FragmentHeader::maskOfCount(count) & ~ackedMask; }
+
+void buildFragment(RadioBufferPointer buffer, unsigned int index, bool isAckRequest) {
+	DynamicPacket packet(buffer, Format);
+	RadioBufferPointer payload = packet.payload();
+
+	const uint32_t offset = index * payloadLength;
+	const uint32_t dataLength = (messageLength - offset) < payloadLength ? (messageLength - offset) : payloadLength;
+
+	uint8_t flags = 0;
+	if (index == count - 1) flags |= FragmentHeader::Last;
+	if (isAckRequest) flags |= FragmentHeader::AckRequest;
+
+	payload[0] = flags | messageID;
+	payload[1] = index;
+	for (uint32_t i = 0; i < dataLength; i++) {
+		payload[FragmentHeader::FragmentHeaderLength + i] = message[offset + i];
+	}
+	packet.setLength(FragmentHeader::FragmentHeaderLength + dataLength);
+}
+
+void beginRound() { roundMask = unackedMask(); }
+
+}  // namespace
+
+
+
+void Fragmenter::configure(uint8_t aPayloadLength) {
+	assert(aPayloadLength > 0);
+	assert(aPayloadLength + FragmentHeader::FragmentHeaderLength <= Format.maxLength());
+	payloadLength = aPayloadLength;
+}
+
+
+bool Fragmenter::start(uint8_t aMessageID, const uint8_t* aMessage, uint16_t length) {
+	assert(payloadLength > 0);
+	assert(aMessageID <= FragmentHeader::MessageIDMask);
+
+	const unsigned int aCount = (length + payloadLength - 1) / payloadLength;
+	if (length == 0 || length > Reassembler::MaxMessageLength || aCount > FragmentHeader::MaxFragmentCount) {
+		return false;
+	}
+
+	message = aMessage;
+	messageLength = length;
+	messageID = aMessageID;
+	count = aCount;
+	ackedMask = 0;
+	sentCount = 0;
+	beginRound();
+	return true;
+}
+
+
+void Fragmenter::service() {
+	while (roundMask != 0 && !BurstTransmitter::isFull()) {
+		const unsigned int index = __builtin_ctzll(roundMask);
+		roundMask &= ~(1ull << index);
+
+		RadioBufferPointer buffer = buffers[nextBuffer];
+		nextBuffer = (nextBuffer + 1) % BufferCount;
+		buildFragment(buffer, index, roundMask == 0);
+
+		bool isQueued = BurstTransmitter::enqueue(buffer);
+		assert(isQueued);
+		(void) isQueued;
+		sentCount++;
+
+		// Else the fragment joins the burst, or BurstTransmitter restarts for it at DISABLED
+		if (!BurstTransmitter::isBusy()) {
+			BurstTransmitter::start();
+		}
+	}
+}
+
+bool Fragmenter::isRoundSent() { return roundMask == 0 && !BurstTransmitter::isBusy(); }
+
+
+
+bool Fragmenter::onAck(const RadioBufferPointer ackPacket) {
+	DynamicPacket packet(ackPacket, Format);
+	RadioBufferPointer payload = packet.payload();
+
+	const bool isOurAck = packet.length() == FragmentHeader::AckLength
+			&& payload[0] == (FragmentHeader::Ack | messageID);
+	if (isOurAck) {
+		ackedMask |= FragmentHeader::readMask(payload + 1) & FragmentHeader::maskOfCount(count);
+		beginRound();
+	}
+	else {
+		onAckMissed();
+	}
+	return isOurAck;
+}
+
+/*
+ * Probe: the lowest unacked fragment, requesting an ack.
+ */
+void Fragmenter::onAckMissed() {
+	const uint64_t unacked = unackedMask();
+	roundMask = unacked & (~unacked + 1);
+}
+
+
+bool Fragmenter::isComplete() { return count > 0 && unackedMask() == 0; }
+unsigned int Fragmenter::fragmentCount() { return count; }
+unsigned int Fragmenter::sentFragmentCount() { return sentCount; }
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+#include "burstTransmitter.h"
+
+
+/*
+ * Sender side of fragmentation: a message longer than one packet (MAXLEN) goes as numbered fragments.
+ *
+ * Fragments go back to back through BurstTransmitter (no wait between fragments),
+ * only the last fragment of a round requests an ack (see FragmentHeader.)
+ * The receiver (Reassembler) acks with a mask of all fragments received: selective repeat.
+ * The next round sends only fragments not acked.
+ * If the ack is missed, the next round is one probe fragment requesting an ack.
+ *
+ * Packet format: dynamic, 8-bit LENGTH, no S0, no S1 (configurePacketLengthDynamic), same at the receiver.
+ * Every fragment but the last carries fragmentPayloadLength bytes of the message.
+ * Message at most FragmentHeader::MaxFragmentCount fragments, and at most Reassembler::MaxMessageLength.
+ *
+ * Driven by the app, e.g. each wake:
+ *   start(...)
+ *   while not isComplete():
+ *     service() until isRoundSent()
+ *     ReceiveWindow::receive(ackBuffer), then onAck(ackBuffer) or onAckMissed()
+ *
+ * Owns BurstTransmitter (and its queue) while sending.
+ * The app's message must not change until isComplete() (fragments are copied from it each round.)
+ *
+ * Singleton, all static class methods.
+ */
+class Fragmenter {
+public:
+	// One TX buffer per BurstTransmitter queue entry
+	static const unsigned int BufferCount = BurstTransmitter::MaxQueueCount;
+
+	/*
+	 * fragmentPayloadLength plus FragmentHeader::FragmentHeaderLength must not exceed MAXLEN.
+	 */
+	static void configure(uint8_t fragmentPayloadLength);
+
+	/*
+	 * Returns false if message too long.
+	 * messageID distinguishes successive messages at the receiver: 0..31, e.g. a counter.
+	 */
+	static bool start(uint8_t messageID, const uint8_t* message, uint16_t length);
+
+	/*
+	 * Queue fragments of this round as BurstTransmitter has room, starting it if idle.
+	 * Radio configured and, while not sending, DISABLED.
+	 */
+	static void service();
+	static bool isRoundSent();
+
+	/*
+	 * ackPacket as received (dynamic format.)  Returns false if not an ack of this message.
+	 * Either way, begins next round.
+	 */
+	static bool onAck(const RadioBufferPointer ackPacket);
+	static void onAckMissed();
+
+	static bool isComplete();
+	static unsigned int fragmentCount();
+	// Count of fragment transmissions, including repeats, for this message
+	static unsigned int sentFragmentCount();
+};
@@ -0,0 +1,136 @@
+#include <cassert>
+#include <cstring>	// memcpy, memset
+
+#include "nrf.h"	// RADIO_FREQUENCY_*_Msk
+
+#include "linkStatistics.h"
+#include "radio.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * All counters live in one Snapshot, so snapshot() and reset() are one memcpy and one memset.
+ * Channel key keeps MAP (nrf52): FREQUENCY 2 is 2402 or 2362 MHz depending on MAP, two channels.
+ * Sequence state is kept apart: it is not a statistic, and reset() must not forget it (or the next packet counts as a gap.)
+ */
+
+namespace {
+
+LinkStatistics::Snapshot statistics;
+
+struct SequenceState {
+	bool isKnown;
+	uint8_t last;
+};
+
+SequenceState sequences[LinkStatistics::MaxLogicalAddressCount];
+
+
+uint32_t channelKey(uint32_t frequency) {
+#ifdef RADIO_FREQUENCY_MAP_Msk
+	return frequency & (RADIO_FREQUENCY_FREQUENCY_Msk | RADIO_FREQUENCY_MAP_Msk);
+#else
+	// nrf51 has no MAP
+	return frequency & RADIO_FREQUENCY_FREQUENCY_Msk;
+#endif
+}
+
+LinkStatistics::Counters* channelCounters(uint32_t frequency) {
+	uint32_t key = channelKey(frequency);
+
+	for (unsigned int i = 0; i < LinkStatistics::MaxChannelCount; i++) {
+		LinkStatistics::ChannelCounters& channel = statistics.channels[i];
+		if (!channel.isUsed) {
+			channel.isUsed = true;
+			channel.frequency = key;
+			return &channel.counters;
+		}
+		if (channel.frequency == key) {
+			return &channel.counters;
+		}
+	}
+	return nullptr;
+}
+
+void count(LinkStatistics::Counters& counters, bool isCRCValid, uint8_t bin) {
+	if (isCRCValid) {
+		counters.crcGood++;
+	}
+	else {
+		counters.crcBad++;
+	}
+	counters.rssiHistogram[bin]++;
+}
+
+}  // namespace
+
+
+
+uint8_t LinkStatistics::rssiBin(unsigned int signalStrength) {
+	const unsigned int strongest = -StrongestBinDBm;
+
+	if (signalStrength <= strongest) {
+		return 0;
+	}
+	unsigned int bin = (signalStrength - strongest) / RSSIBinWidthDB;
+	return bin < RSSIBinCount ? bin : RSSIBinCount - 1;
+}
+
+
+void LinkStatistics::record(uint8_t logicalAddress, uint32_t frequency, bool isCRCValid, unsigned int signalStrength) {
+	assert(logicalAddress < MaxLogicalAddressCount);
+
+	uint8_t bin = rssiBin(signalStrength);
+	count(statistics.addresses[logicalAddress], isCRCValid, bin);
+
+	Counters* channel = channelCounters(frequency);
+	if (channel != nullptr) {
+		count(*channel, isCRCValid, bin);
+	}
+	else {
+		statistics.untrackedChannelPackets++;
+	}
+}
+
+void LinkStatistics::recordReceived() {
+	record(RadioDevice::receivedLogicalAddress(),
+			RadioDevice::frequency(),
+			RadioDevice::isCRCValid(),
+			RadioDevice::receivedSignalStrength());
+}
+
+
+void LinkStatistics::recordSequence(uint8_t logicalAddress, uint8_t sequence) {
+	assert(logicalAddress < MaxLogicalAddressCount);
+
+	SequenceState& state = sequences[logicalAddress];
+	if (state.isKnown) {
+		// Modulo 256
+		uint8_t gap = sequence - state.last;
+		if (gap == 0) {
+			statistics.addresses[logicalAddress].duplicates++;
+			return;
+		}
+		if (gap >= 128) {
+			// Backward
+			return;
+		}
+		statistics.addresses[logicalAddress].missed += gap - 1;
+	}
+	state.isKnown = true;
+	state.last = sequence;
+}
+
+
+
+void LinkStatistics::snapshot(Snapshot& result) {
+	memcpy(&result, &statistics, sizeof(statistics));
+}
+
+/*
+ * Channel slots are freed too, so tracking follows a changed channel plan.
+ */
+void LinkStatistics::reset() {
+	memset(&statistics, 0, sizeof(statistics));
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * Link quality counters, accumulated per packet in fixed memory (no heap.)
+ *
+ * Per logical address (RXMATCH) and per channel (FREQUENCY register: FREQUENCY field and, on nrf52, MAP):
+ * - count of packets with good and bad CRC
+ * - histogram of RSSI
+ * Per logical address only:
+ * - duplicate and missed sequence numbers (from a sequence number the app carries in its payload)
+ *
+ * Packet error rate is crcBad / (crcGood + crcBad); loss includes missed, which never reached the radio.
+ *
+ * Channels are tracked in MaxChannelCount slots, claimed by frequency in order first received.
+ * Packets on further channels count only in untrackedChannelPackets.
+ *
+ * Singleton, all static class methods.
+ * record() may be called from the radio ISR while the app takes snapshot():
+ * each counter is a word, read and written whole, so a snapshot racing a record is off by at most that one packet.
+ */
+class LinkStatistics {
+public:
+	static const unsigned int MaxLogicalAddressCount = 8;
+	static const unsigned int MaxChannelCount = 8;
+
+	/*
+	 * RSSI bins of RSSIBinWidthDB, the first at StrongestBinDBm and stronger, the last at its floor and weaker.
+	 */
+	static const unsigned int RSSIBinCount = 8;
+	static const unsigned int RSSIBinWidthDB = 8;
+	static const int StrongestBinDBm = -40;
+
+	struct Counters {
+		uint32_t crcGood;
+		uint32_t crcBad;
+		uint32_t rssiHistogram[RSSIBinCount];
+
+		uint32_t packetCount() const { return crcGood + crcBad; }
+	};
+
+	struct AddressCounters : Counters {
+		uint32_t duplicates;
+		uint32_t missed;
+	};
+
+	struct ChannelCounters {
+		// FREQUENCY register masked to its FREQUENCY and MAP fields
+		uint32_t frequency;
+		bool isUsed;
+		Counters counters;
+	};
+
+	struct Snapshot {
+		AddressCounters addresses[MaxLogicalAddressCount];
+		ChannelCounters channels[MaxChannelCount];
+		uint32_t untrackedChannelPackets;
+	};
+
+	/*
+	 * frequency as from RadioDevice::frequency() (whole register: other bits are masked off.)
+	 * signalStrength as from RadioDevice::receivedSignalStrength() (magnitude of negative dBm.)
+	 */
+	static void record(uint8_t logicalAddress, uint32_t frequency, bool isCRCValid, unsigned int signalStrength);
+	/*
+	 * From the radio, for the packet just received (END.)
+	 * Requires RSSI sampled (e.g. shortcut ADDRESS->RSSISTART.)
+	 */
+	static void recordReceived();
+
+	/*
+	 * For a packet with good CRC only.
+	 * Gap to the last sequence, modulo 256:
+	 * - 0 is a duplicate
+	 * - 1..127 is forward, gap - 1 counted as missed
+	 * - 128..255 is a backward jump (a late packet, or the peer restarting): not counted, last sequence kept
+	 */
+	static void recordSequence(uint8_t logicalAddress, uint8_t sequence);
+
+	static uint8_t rssiBin(unsigned int signalStrength);
+
+	static void snapshot(Snapshot&);
+	static void reset();
+};
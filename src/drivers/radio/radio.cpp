@@ -35,7 +35,12 @@
  * and this might save more power?
  */
 void RadioDevice::powerOn() { NRF_RADIO->POWER = 1; MCU::flushWriteCache(); }
-void RadioDevice::powerOff() { NRF_RADIO->POWER = 0; MCU::flushWriteCache(); }
+void RadioDevice::powerOff() {
+	NRF_RADIO->POWER = 0;
+	MCU::flushWriteCache();
+	// Registers will be reset on powerOn
+	resetConfigurationShadow();
+}
 /*
  * Reset condition is power on.
  * !!! Radio registers are undefined while powered off.
@@ -78,6 +83,16 @@ void RadioDevice::startTXTask() {
 	NRF_RADIO->TASKS_TXEN = 1;
 }
 
+/*
+ * RX -STOP-> RXIDLE -START-> RX, so START latches PACKETPTR again.
+ * No ramp up, no DISABLED event.
+ */
+void RadioDevice::restartRXTask() {
+	NRF_RADIO->TASKS_STOP = 1;
+	NRF_RADIO->TASKS_START = 1;
+	MCU::flushWriteCache();
+}
+
 /*
  * This is general purpose (to disable both TX and RX.)
  * Note that interrupt can be enabled for EVENTS_DISABLED,
@@ -91,6 +106,12 @@ void RadioDevice::startDisablingTask(){
 }
 
 
+uint32_t* RadioDevice::getTXEnableTaskRegisterAddress() { return (uint32_t*) &NRF_RADIO->TASKS_TXEN; }
+uint32_t* RadioDevice::getRXEnableTaskRegisterAddress() { return (uint32_t*) &NRF_RADIO->TASKS_RXEN; }
+uint32_t* RadioDevice::getDisableTaskRegisterAddress() { return (uint32_t*) &NRF_RADIO->TASKS_DISABLE; }
+uint32_t* RadioDevice::getAddressEventRegisterAddress() { return (uint32_t*) &NRF_RADIO->EVENTS_ADDRESS; }
+
+
 
 void RadioDevice::clearDisabledEvent(){
 	NRF_RADIO->EVENTS_DISABLED = 0;
@@ -107,6 +128,10 @@ bool RadioDevice::isDisabledState() {
 	return NRF_RADIO->STATE == RADIO_STATE_STATE_Disabled;
 }
 
+bool RadioDevice::isTransmitRampUpState() {
+	return NRF_RADIO->STATE == RADIO_STATE_STATE_TxRu || NRF_RADIO->STATE == RADIO_STATE_STATE_TxIdle;
+}
+
 // Is radio in middle of receiving packet?
 bool RadioDevice::isReceiveInProgressEvent() {
 	/*
@@ -126,6 +151,26 @@ void RadioDevice::clearReceiveInProgressEvent() {
 }
 
 
+bool RadioDevice::isReadyEvent() {
+	return NRF_RADIO->EVENTS_READY; // == 1
+}
+
+void RadioDevice::clearReadyEvent() {
+	NRF_RADIO->EVENTS_READY = 0;
+	MCU::flushWriteCache();
+}
+
+
+bool RadioDevice::isEndEvent() {
+	return NRF_RADIO->EVENTS_END; // == 1
+}
+
+void RadioDevice::clearEndEvent() {
+	NRF_RADIO->EVENTS_END = 0;
+	MCU::flushWriteCache();
+}
+
+
 bool RadioDevice::isDisabledEventSet() {
 	return NRF_RADIO->EVENTS_DISABLED; // == 1
 }
@@ -168,6 +213,17 @@ void RadioDevice::enableInterruptForDisabledEvent() { NRF_RADIO->INTENSET = RADI
 void RadioDevice::disableInterruptForDisabledEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_DISABLED_Msk; }
 bool RadioDevice::isEnabledInterruptForDisabledEvent() { return NRF_RADIO->INTENSET & RADIO_INTENSET_DISABLED_Msk; }
 
+void RadioDevice::enableInterruptForAddressEvent() { NRF_RADIO->INTENSET = RADIO_INTENSET_ADDRESS_Msk; }
+void RadioDevice::disableInterruptForAddressEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_ADDRESS_Msk; }
+void RadioDevice::enableInterruptForEndEvent() { NRF_RADIO->INTENSET = RADIO_INTENSET_END_Msk; }
+void RadioDevice::disableInterruptForEndEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_END_Msk; }
+void RadioDevice::enableInterruptForReadyEvent() { NRF_RADIO->INTENSET = RADIO_INTENSET_READY_Msk; }
+void RadioDevice::disableInterruptForReadyEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_READY_Msk; }
+void RadioDevice::enableInterruptForRSSISampleDoneEvent() { NRF_RADIO->INTENSET = RADIO_INTENSET_RSSIEND_Msk; }
+void RadioDevice::disableInterruptForRSSISampleDoneEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_RSSIEND_Msk; }
+void RadioDevice::enableInterruptForBitCounterMatchEvent() { NRF_RADIO->INTENSET = RADIO_INTENSET_BCMATCH_Msk; }
+void RadioDevice::disableInterruptForBitCounterMatchEvent() { NRF_RADIO->INTENCLR = RADIO_INTENCLR_BCMATCH_Msk; }
+
 
 /*
  * The radio emits events for many state transitions we are not interested in.
@@ -177,26 +233,89 @@ bool RadioDevice::isEnabledInterruptForDisabledEvent() { return NRF_RADIO->INTEN
  *
  * !!! The state diagram also has a transition without a condition:  /Disabled from TXDISABLE to DISABLED.
  *
- * These shortcuts are:
- * - from state TXRU directly to state TX (without explicit start READY task, bypassing state TXIDLE)
- * - from state TX   directly to state DISABLED (without explicit DISABLE task, bypassing states TXIDLE and TXDISABLE)
+ * None:
+ * - no shortcuts, radio stops in RXIDLE/TXIDLE after ramp up
+ *
+ * SampleSignal:
+ * - from state RXRU directly to state RX, nothing else.
+ *   RSSI is valid only in RX (after START), not RXIDLE.
+ *   Caller disables address match (configureRXLogicalAddresses(0)) so no packet is received into PACKETPTR.
+ *
+ * All other profiles:
+ * - from state TXRU/RXRU directly to state TX/RX (without explicit START task, bypassing state TXIDLE/RXIDLE)
+ * - ADDRESS starts RSSI sample.  I assume it doesn't take any more power to always sample RSSI
+ *
+ * SinglePacket:
+ * - from state TX/RX directly to state DISABLED (without explicit DISABLE task, bypassing states TXIDLE and TXDISABLE)
+ *
+ * ContinuousReceive:
+ * - on END, START again (back to listening for address) instead of DISABLE
+ *   START latches PACKETPTR, so the next packet goes to whatever PACKETPTR holds at END.
+ *   Radio stays in RX until startDisablingTask().
+ *
+ * TransmitThenReceive, ReceiveThenTransmit:
+ * - as SinglePacket, then DISABLED event enables the opposite direction.
+ *   Turnaround takes only the ramp-up time, no ISR latency.
+ *   The turnaround shortcut must be cleared (clearTurnaroundShortcuts) before the second DISABLED.
+ *
+ * TransmitBurst:
+ * - same shortcuts as ReceiveThenTransmit, but starting in TX: DISABLED enables TX again.
+ *   Radio sends packet after packet (at whatever PACKETPTR holds at each START) until clearTurnaroundShortcuts().
  */
-void RadioDevice::setShortcutsAvoidSomeEvents() {
-	//
+namespace {
+
+const uint32_t CommonShortcuts = RADIO_SHORTS_READY_START_Msk // shortcut READY event to START task
+		| RADIO_SHORTS_ADDRESS_RSSISTART_Msk;	 // shortcut ADDRESS event to RSSISTART task
+
+const uint32_t TurnaroundShortcuts = RADIO_SHORTS_DISABLED_RXEN_Msk | RADIO_SHORTS_DISABLED_TXEN_Msk;
+
+}  // namespace
+
+
+void RadioDevice::setShortcuts(RadioShortcutProfile profile) {
+	invalidateConfigurationShadow();
+	uint32_t value;
+
+	switch(profile) {
+	case RadioShortcutProfile::ContinuousReceive:
+		value = CommonShortcuts | RADIO_SHORTS_END_START_Msk;
+		break;
+	case RadioShortcutProfile::TransmitThenReceive:
+		value = CommonShortcuts | RADIO_SHORTS_END_DISABLE_Msk | RADIO_SHORTS_DISABLED_RXEN_Msk;
+		break;
+	case RadioShortcutProfile::ReceiveThenTransmit:
+	case RadioShortcutProfile::TransmitBurst:
+		value = CommonShortcuts | RADIO_SHORTS_END_DISABLE_Msk | RADIO_SHORTS_DISABLED_TXEN_Msk;
+		break;
+	case RadioShortcutProfile::None:
+		value = 0;
+		break;
+	case RadioShortcutProfile::SampleSignal:
+		value = RADIO_SHORTS_READY_START_Msk;
+		break;
+	case RadioShortcutProfile::SinglePacket:
+	default:
+		value = CommonShortcuts | RADIO_SHORTS_END_DISABLE_Msk;
+	}
 	// In other words, make automatic transitions in state diagram.
-	NRF_RADIO->SHORTS = RADIO_SHORTS_READY_START_Msk // shortcut READY event to START task
-			| RADIO_SHORTS_END_DISABLE_Msk		 // shortcut END event to DISABLE task
-			// next is optional.  I assume it doesn't take any more power to always sample RSSI
-			| RADIO_SHORTS_ADDRESS_RSSISTART_Msk;	 // shortcut ADDRESS event to RSSISTART task
+	NRF_RADIO->SHORTS = value;
 
 	// RadioHead nrf51
 	// These shorts will make the radio transition from Ready to Start to Disable automatically
 	// for both TX and RX, which makes for much shorter on-air times
 	// NRF_RADIO->SHORTS = (RADIO_SHORTS_READY_START_Enabled << RADIO_SHORTS_READY_START_Pos)
 	//	              | (RADIO_SHORTS_END_DISABLE_Enabled << RADIO_SHORTS_END_DISABLE_Pos);
+}
 
+void RadioDevice::clearTurnaroundShortcuts() {
+	invalidateConfigurationShadow();
+	NRF_RADIO->SHORTS = NRF_RADIO->SHORTS & ~TurnaroundShortcuts;
+	MCU::flushWriteCache();
 }
 
+void RadioDevice::setShortcutsAvoidSomeEvents() { setShortcuts(RadioShortcutProfile::SinglePacket); }
+void RadioDevice::setShortcutsContinuousReceive() { setShortcuts(RadioShortcutProfile::ContinuousReceive); }
+
 
 
 
@@ -225,3 +344,61 @@ unsigned int RadioDevice::receivedSignalStrength() {
 	unsigned int result = NRF_RADIO->RSSISAMPLE;
 	return result;
 }
+
+
+
+void RadioDevice::startRSSISample() {
+	NRF_RADIO->TASKS_RSSISTART = 1;
+}
+
+bool RadioDevice::isRSSISampleDone() {
+	return NRF_RADIO->EVENTS_RSSIEND;	// == 1
+}
+
+void RadioDevice::clearRSSISampleDoneEvent() {
+	NRF_RADIO->EVENTS_RSSIEND = 0;
+	MCU::flushWriteCache();
+}
+
+unsigned int RadioDevice::sampleSignalStrength() {
+	clearRSSISampleDoneEvent();
+	startRSSISample();
+	while (!isRSSISampleDone()) {}
+	return receivedSignalStrength();
+}
+
+
+
+// Bit counter
+
+void RadioDevice::configureBitCounter(uint32_t bitCount) {
+	NRF_RADIO->BCC = bitCount;
+}
+
+/*
+ * setShortcuts() clears this shortcut: call after it.
+ */
+void RadioDevice::enableBitCounterShortcut() {
+	invalidateConfigurationShadow();
+	NRF_RADIO->SHORTS = NRF_RADIO->SHORTS | RADIO_SHORTS_ADDRESS_BCSTART_Msk;
+}
+
+void RadioDevice::disableBitCounterShortcut() {
+	invalidateConfigurationShadow();
+	NRF_RADIO->SHORTS = NRF_RADIO->SHORTS & ~RADIO_SHORTS_ADDRESS_BCSTART_Msk;
+	MCU::flushWriteCache();
+}
+
+bool RadioDevice::isBitCounterMatchEvent() {
+	return NRF_RADIO->EVENTS_BCMATCH;	// == 1
+}
+
+void RadioDevice::clearBitCounterMatchEvent() {
+	NRF_RADIO->EVENTS_BCMATCH = 0;
+	MCU::flushWriteCache();
+}
+
+
+RadioBufferPointer RadioDevice::packetAddress() {
+	return reinterpret_cast<RadioBufferPointer>((uintptr_t) NRF_RADIO->PACKETPTR);
+}
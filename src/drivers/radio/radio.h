@@ -8,6 +8,21 @@
 
 #include "types.h"	// RadioBufferPointer
 
+struct DynamicPacketFormat;
+struct RadioConfig;
+
+
+/*
+ * Physical (network) addresses for all 8 logical addresses.
+ * Logical address 0 is prefixes[0] + base0.
+ * Logical addresses 1..7 are prefixes[i] + base1 (they share base1.)
+ */
+struct RadioAddressTable {
+	uint32_t base0;
+	uint32_t base1;
+	uint8_t prefixes[8];
+};
+
 
 /*
  * Low-level driver for radio peripheral
@@ -26,12 +41,24 @@ public:
 	static void configureFixedFrequency(uint8_t frequencyIndex);
 	static void configureFixedLogicalAddress();
 	static void configureNetworkAddressPool();
+
+	// Address table: all 8 logical addresses
+	static void configureAddressTable(const RadioAddressTable&);
+	static void configureBaseAddress(const uint8_t baseIndex, const uint32_t base);
+	static void configurePrefix(const uint8_t logicalAddress, const uint8_t prefix);
+	// Per packet
+	static void configureTXLogicalAddress(const uint8_t logicalAddress);
+	// Bit i enables logical address i
+	static void configureRXLogicalAddresses(const uint8_t mask);
 	static void configureShortCRC();
 	static void configureMediumCRC();
+	static void configureBLECRC();
 	static void configureStaticPacketFormat(const uint8_t, const uint8_t );
+	static void configureDynamicPacketFormat(const DynamicPacketFormat&, const uint8_t MaxPayloadCount, const uint8_t AddressLength);
 	static void configureWhiteningOn();	// Must follow configureStaticPacketFormat()
 	static void configureWhiteningSeed(int);
 	static void configureMegaBitrate(unsigned int baud);
+	static void configureMode(RadioMode);
 	static void configureFastRampUp();
 
 	static void configureXmitPower(int8_t dBm);
@@ -40,12 +67,22 @@ public:
 	// value that indicates has been configured (not in reset configuration)
 	static uint32_t configurationSignature();
 
+	/*
+	 * Whole configuration in one pass, skipping registers unchanged since last apply or powerOff.
+	 * See radioConfigShadow.cpp
+	 */
+	static void applyConfiguration(const RadioConfig&);
+	static void snapshotConfiguration(RadioConfig&);
+	static void invalidateConfigurationShadow();
+
 private:
 	static void configureShortCRCLength();
 	static void configureShortCRCGeneratorInit();
 	static void configureShortCRCPolynomialForShortData();
 	static void configureStaticOnAirPacketFormat();
 	static void configureStaticPayloadFormat(const uint8_t PayloadCount, const uint8_t AddressLength);
+	static void configureDynamicOnAirPacketFormat(const DynamicPacketFormat&);
+	static void configureDynamicPayloadFormat(const uint8_t MaxPayloadCount, const uint8_t AddressLength);
 
 
 
@@ -53,14 +90,30 @@ private:
 	static void setFirstNetworkAddressInPool(const uint8_t* address, const uint8_t len);
 	static void setFirstNetworkAddressInPool();
 
+	static void resetConfigurationShadow();
+
 public:
 	static void configurePacketAddress(RadioBufferPointer data);
-	static void configurePacketLengthDynamic(uint8_t length);
+	/*
+	 * Set PACKETPTR while radio is active (not DISABLED).
+	 * See ContinuousReceiver.
+	 */
+	static void configureNextPacketAddress(RadioBufferPointer data);
+	/*
+	 * Switch to dynamic format with default header (8-bit LENGTH, no S0, no S1)
+	 * and given max payload, keeping BALEN and whitening.
+	 */
+	static void configurePacketLengthDynamic(uint8_t maxPayloadCount);
 
 
 
 	// Getters of configuration
+	// Whole FREQUENCY register, including MAP on nrf52
 	static uint32_t frequency();
+	// Restore a value from frequency()
+	static void restoreFrequency(uint32_t frequencyRegister);
+	// RXADDRESSES: mask of logical addresses enabled for receive
+	static uint8_t receiveLogicalAddresses();
 
 
 	static bool isCRCValid();
@@ -79,6 +132,11 @@ public:
 	// Tasks and events
 	static void startRXTask();
 	static void startTXTask();
+	/*
+	 * From RX (listening): back to listening, receiving into the buffer PACKETPTR now holds.
+	 * A packet being received is lost.
+	 */
+	static void restartRXTask();
 #ifdef USE_PACKET_DONE_FOR_EOT
 	static bool isPacketDone();
 	static void clearPacketDoneEvent();
@@ -94,15 +152,38 @@ public:
 	 * DISABLE event and sate set by either DISABLE Task OR after packet done
 	 */
 	static void startDisablingTask();
+
+	/*
+	 * Needed to hook tasks to PPI.
+	 */
+	static uint32_t* getTXEnableTaskRegisterAddress();
+	static uint32_t* getRXEnableTaskRegisterAddress();
+	static uint32_t* getDisableTaskRegisterAddress();
+	// Needed to hook events to PPI.
+	static uint32_t* getAddressEventRegisterAddress();
+
 	// events
 	static bool isDisabledEventSet();
 	static void clearDisabledEvent();
 	// state remains in effect even after even is cleared
 	static bool isDisabledState();
+	// TXEN done, packet not yet started (TXRU, TXIDLE)
+	static bool isTransmitRampUpState();
 
 	static bool isReceiveInProgressEvent();
 	static void clearReceiveInProgressEvent();
 
+	// Ramp up done (RXIDLE or TXIDLE, unless shortcut READY_START)
+	static bool isReadyEvent();
+	static void clearReadyEvent();
+
+	/*
+	 * END event: end of packet (RX or TX), regardless of USE_PACKET_DONE_FOR_EOT.
+	 * Used when radio stays in RX between packets (see ContinuousReceiver.)
+	 */
+	static bool isEndEvent();
+	static void clearEndEvent();
+
 #ifdef USE_PACKET_DONE_FOR_EOT
 	static void enableInterruptForPacketDoneEvent();
 	static void disableInterruptForPacketDoneEvent();
@@ -114,11 +195,59 @@ public:
 	static bool isEnabledInterruptForDisabledEvent();
 #endif
 
+	static void enableInterruptForAddressEvent();
+	static void disableInterruptForAddressEvent();
+	static void enableInterruptForEndEvent();
+	static void disableInterruptForEndEvent();
+	static void enableInterruptForReadyEvent();
+	static void disableInterruptForReadyEvent();
+	static void enableInterruptForRSSISampleDoneEvent();
+	static void disableInterruptForRSSISampleDoneEvent();
+	static void enableInterruptForBitCounterMatchEvent();
+	static void disableInterruptForBitCounterMatchEvent();
+
+	static void setShortcuts(RadioShortcutProfile);
+	/*
+	 * Clear DISABLED_RXEN and DISABLED_TXEN, leaving other shortcuts.
+	 * Call after a turnaround has happened, else radio ping-pongs forever.
+	 */
+	static void clearTurnaroundShortcuts();
+
+	// Same as setShortcuts(SinglePacket)
 	static void setShortcutsAvoidSomeEvents();
+	// Same as setShortcuts(ContinuousReceive)
+	static void setShortcutsContinuousReceive();
 
 	/*
 	 * Result is for most recently received packet.
 	 * If called before any receive, result is meaningless.
 	 */
 	static unsigned int receivedSignalStrength();
+
+	/*
+	 * Explicit RSSI sample, without a packet.
+	 * Radio must be in state RX, i.e. after START: a sample in RXIDLE is not valid.
+	 * To sample without receiving, disable address match (configureRXLogicalAddresses(0))
+	 * and ramp up with shortcut profile SampleSignal.
+	 * Sample is short compared to ramp up (see datasheet, RSSI period.)
+	 */
+	static void startRSSISample();
+	static bool isRSSISampleDone();
+	static void clearRSSISampleDoneEvent();
+	// Spin until sample done, return value as receivedSignalStrength()
+	static unsigned int sampleSignalStrength();
+
+	/*
+	 * Bit counter: BCMATCH event after bitCount bits following the address (header bits, then payload.)
+	 * The shortcut (ADDRESS->BCSTART) starts the counter on every packet, leaving other shortcuts.
+	 * Bytes counted so far are already in RAM at BCMATCH.
+	 */
+	static void configureBitCounter(uint32_t bitCount);
+	static void enableBitCounterShortcut();
+	static void disableBitCounterShortcut();
+	static bool isBitCounterMatchEvent();
+	static void clearBitCounterMatchEvent();
+
+	// PACKETPTR as last written, e.g. buffer of packet being received in SinglePacket
+	static RadioBufferPointer packetAddress();
 };
@@ -15,10 +15,73 @@
 void RadioDevice::configureFixedLogicalAddress(){
 	// FUTURE: parameter
 
-	NRF_RADIO->TXADDRESS   = 0x00;	// Transmit to logical address 0 (defined by PREFIX0.A + BASE0)
+	configureTXLogicalAddress(0);	// Transmit to logical address 0 (defined by PREFIX0.AP0 + BASE0)
 
 	// There are eight RX addresses.  We only enable one (setting one bit out of eight).
-	NRF_RADIO->RXADDRESSES = 0x01; // Enable receive logical address 0 (PREFIX0.A + BASE0)
+	configureRXLogicalAddresses(0x01); // Enable receive logical address 0 (PREFIX0.AP0 + BASE0)
+}
+
+
+void RadioDevice::configureTXLogicalAddress(const uint8_t logicalAddress) {
+	invalidateConfigurationShadow();
+	assert(logicalAddress < 8);
+	NRF_RADIO->TXADDRESS = logicalAddress;
+}
+
+void RadioDevice::configureRXLogicalAddresses(const uint8_t mask) {
+	invalidateConfigurationShadow();
+	NRF_RADIO->RXADDRESSES = mask;
+}
+
+uint8_t RadioDevice::receiveLogicalAddresses() { return NRF_RADIO->RXADDRESSES; }
+
+
+/*
+ * Sets whole pool.
+ * See setFirstNetworkAddressInPool for rules on outlawed values.
+ */
+void RadioDevice::configureAddressTable(const RadioAddressTable& table) {
+	invalidateConfigurationShadow();
+	configureBaseAddress(0, table.base0);
+	configureBaseAddress(1, table.base1);
+
+	// Prefixes packed four to a register, logical address i in byte i%4
+	NRF_RADIO->PREFIX0 = table.prefixes[0]
+			| (table.prefixes[1] << 8)
+			| (table.prefixes[2] << 16)
+			| ((uint32_t) table.prefixes[3] << 24);
+	NRF_RADIO->PREFIX1 = table.prefixes[4]
+			| (table.prefixes[5] << 8)
+			| (table.prefixes[6] << 16)
+			| ((uint32_t) table.prefixes[7] << 24);
+}
+
+/*
+ * BASE0 is for logical address 0, BASE1 for logical addresses 1..7
+ */
+void RadioDevice::configureBaseAddress(const uint8_t baseIndex, const uint32_t base) {
+	invalidateConfigurationShadow();
+	assert(baseIndex <= 1);
+	if (baseIndex == 0)
+		NRF_RADIO->BASE0 = base;
+	else
+		NRF_RADIO->BASE1 = base;
+}
+
+/*
+ * Read-modify-write one byte of PREFIX0 or PREFIX1: does not destroy other prefixes.
+ */
+void RadioDevice::configurePrefix(const uint8_t logicalAddress, const uint8_t prefix) {
+	invalidateConfigurationShadow();
+	assert(logicalAddress < 8);
+
+	const unsigned int shift = (logicalAddress % 4) * 8;
+	const uint32_t mask = 0xFFUL << shift;
+
+	if (logicalAddress < 4)
+		NRF_RADIO->PREFIX0 = (NRF_RADIO->PREFIX0 & ~mask) | ((uint32_t) prefix << shift);
+	else
+		NRF_RADIO->PREFIX1 = (NRF_RADIO->PREFIX1 & ~mask) | ((uint32_t) prefix << shift);
 }
 
 
@@ -31,6 +94,7 @@ void RadioDevice::configureFixedLogicalAddress(){
  * The 2 bases are in BASE0..BASE1
  */
 void RadioDevice::configureNetworkAddressPool() {
+	invalidateConfigurationShadow();
 	// Power on default (prefix 0, base 0) is adequate, but not optimal
 	// Optimal address extends preamble
 
@@ -46,7 +110,8 @@ void RadioDevice::configureNetworkAddressPool() {
 
 // Fill all bytes of first network address to 0xE7
 void RadioDevice::setFirstNetworkAddressInPool() {
-	NRF_RADIO->PREFIX0	  = (0xE7 << RADIO_PREFIX0_AP0_Pos);	// Destroys other prefixes
+	invalidateConfigurationShadow();
+	configurePrefix(0, 0xE7);
 	NRF_RADIO->BASE0 = 0xE7E7E7E7;
 }
 
@@ -55,6 +120,7 @@ void RadioDevice::setFirstNetworkAddressInPool() {
 // FUTURE this is setting one, add a parameter index.
 void RadioDevice::setFirstNetworkAddressInPool(const uint8_t* address, const uint8_t len)
 {
+	invalidateConfigurationShadow();
 	// !!! See "RADIO.Address configuration" in data sheet
 	// !!! During xmit, base address register is truncated starting from LSByte (when BALEN < 4)
 	// !!! LSByte of truncated address is first transmitted, and should not be one of four outlawed values.
@@ -66,10 +132,10 @@ void RadioDevice::setFirstNetworkAddressInPool(const uint8_t* address, const uin
 	// This implementation is flawed, but adequate for my purposes.
 
 	// First byte is the prefix
-	NRF_RADIO->PREFIX0	  = ((address[0] << RADIO_PREFIX0_AP0_Pos) & RADIO_PREFIX0_AP0_Msk);
+	configurePrefix(0, address[0]);
 
 	// remainder are base
-	uint32_t base;
+	uint32_t base = 0;
 	memcpy(&base, address+1, len-1);
 	NRF_RADIO->BASE0 = base;
 	// This leaves default 0 in MSBytes???
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <cassert>
+
+#include "nrf.h"	// NRF52_SERIES, __get_PRIMASK
+
+#include "radioBufferPool.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Free mask: bit i set means buffer i is free.
+ * NRF52_SERIES: std::atomic compare_exchange compiles to LDREX/STREX on Cortex-M4, no interrupt masking.
+ * nrf51 (Cortex-M0) has no LDREX/STREX (std::atomic read-modify-write would be a libatomic call):
+ * there each read-modify-write of the mask is a few instructions with interrupts masked (PRIMASK),
+ * restoring PRIMASK as found, so it also nests in a caller's critical section.
+ * The owner array is informational for asserts and for owner(); the free mask alone decides allocation.
+ */
+
+static_assert(RadioBufferPool::BufferCount <= 32, "free mask is one word");
+static_assert(RadioBufferPool::BufferSize % 4 == 0, "buffers must stay word aligned");
+
+namespace {
+
+__attribute__((section(".bss.radioBufferPool"), aligned(4)))
+uint8_t storage[RadioBufferPool::BufferCount][RadioBufferPool::BufferSize];
+
+volatile RadioBufferOwner owners[RadioBufferPool::BufferCount];
+
+const uint32_t AllFree = RadioBufferPool::BufferCount == 32 ? 0xFFFFFFFF : (1u << RadioBufferPool::BufferCount) - 1;
+#ifdef NRF52_SERIES
+std::atomic<uint32_t> freeMask(AllFree);
+#else
+volatile uint32_t freeMask = AllFree;
+#endif
+
+
+unsigned int indexOf(const RadioBufferPointer buffer) {
+	assert(RadioBufferPool::isPoolBuffer(buffer));
+	return (buffer - &storage[0][0]) / RadioBufferPool::BufferSize;
+}
+
+void transfer(const RadioBufferPointer buffer, RadioBufferOwner from, RadioBufferOwner to) {
+	unsigned int index = indexOf(buffer);
+	assert(owners[index] == from);
+	(void) from;
+	owners[index] = to;
+}
+
+
+#ifdef NRF52_SERIES
+
+/*
+ * Clears lowest set bit of mask.  Returns index of that bit, or -1 if none free.
+ */
+int takeFirstFree() {
+	uint32_t expected = freeMask.load();
+	uint32_t desired;
+	unsigned int index;
+
+	do {
+		if (expected == 0) {
+			return -1;
+		}
+		index = __builtin_ctz(expected);
+		desired = expected & ~(1u << index);
+	} while (!freeMask.compare_exchange_weak(expected, desired));
+	return index;
+}
+
+void markFree(unsigned int index) { freeMask.fetch_or(1u << index); }
+
+uint32_t loadFreeMask() { return freeMask.load(); }
+
+#else
+
+int takeFirstFree() {
+	int index = -1;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (freeMask != 0) {
+		index = __builtin_ctz(freeMask);
+		freeMask = freeMask & ~(1u << index);
+	}
+	__set_PRIMASK(primask);
+	return index;
+}
+
+void markFree(unsigned int index) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	freeMask = freeMask | (1u << index);
+	__set_PRIMASK(primask);
+}
+
+// Single word read is atomic
+uint32_t loadFreeMask() { return freeMask; }
+
+#endif
+
+}  // namespace
+
+
+
+RadioBufferPointer RadioBufferPool::allocate() {
+	int index = takeFirstFree();
+
+	if (index < 0) {
+		return nullptr;
+	}
+	owners[index] = RadioBufferOwner::App;
+	return storage[index];
+}
+
+
+void RadioBufferPool::release(const RadioBufferPointer buffer) {
+	unsigned int index = indexOf(buffer);
+	transfer(buffer, RadioBufferOwner::App, RadioBufferOwner::Free);
+	// After owner written: once in mask, another context may allocate it
+	markFree(index);
+}
+
+
+void RadioBufferPool::transferToRadioTX(const RadioBufferPointer buffer) {
+	transfer(buffer, RadioBufferOwner::App, RadioBufferOwner::RadioTX);
+}
+
+void RadioBufferPool::transferToRadioRX(const RadioBufferPointer buffer) {
+	transfer(buffer, RadioBufferOwner::App, RadioBufferOwner::RadioRX);
+}
+
+void RadioBufferPool::transferToApp(const RadioBufferPointer buffer) {
+	unsigned int index = indexOf(buffer);
+	assert(owners[index] == RadioBufferOwner::RadioTX || owners[index] == RadioBufferOwner::RadioRX);
+	owners[index] = RadioBufferOwner::App;
+}
+
+
+RadioBufferOwner RadioBufferPool::owner(const RadioBufferPointer buffer) { return owners[indexOf(buffer)]; }
+
+/*
+ * Must point at the start of a buffer.
+ */
+bool RadioBufferPool::isPoolBuffer(const RadioBufferPointer buffer) {
+	const volatile uint8_t* first = &storage[0][0];
+	const volatile uint8_t* end = first + sizeof(storage);
+
+	return buffer >= first && buffer < end && (buffer - first) % BufferSize == 0;
+}
+
+unsigned int RadioBufferPool::freeCount() { return __builtin_popcount(loadFreeMask()); }
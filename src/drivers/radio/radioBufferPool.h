@@ -0,0 +1,58 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Who may touch a pool buffer.
+ * While owned by the radio, EasyDMA may read (TX) or write (RX) it at any time.
+ */
+enum class RadioBufferOwner : uint8_t { Free, App, RadioTX, RadioRX };
+
+
+/*
+ * Fixed pool of packet buffers, for zero-copy packet paths.
+ *
+ * Buffers are statically allocated in Data RAM (section .bss.radioBufferPool, which linker scripts place with .bss),
+ * word aligned, each large enough for any packet format (header and 255 byte payload.)
+ * EasyDMA can only reach Data RAM: a packet in a const (flash) array, or on a stack the compiler put elsewhere, silently fails.
+ *
+ * Each buffer has one owner at a time, and ownership moves explicitly:
+ *
+ *   Free -allocate-> App -transferToRadioTX/RX-> RadioTX/RadioRX -transferToApp-> App -release-> Free
+ *
+ * Only the current owner may transfer a buffer (asserted.)
+ * So a receive path is: allocate, transferToRadioRX, configurePacketAddress, ... END: transferToApp, hand pointer to app.
+ * A transmit path is the same in the other direction.  No copying into or out of a single static buffer.
+ *
+ * allocate and release update a mask of free buffers atomically, so both app and ISR may allocate
+ * (e.g. an ISR arming the next RX buffer.)  Lock-free (compare-and-swap) on nRF52;
+ * on nrf51, which has no compare-and-swap, interrupts are masked for a few instructions.
+ * The owner of a buffer is written only by the context that owns it.
+ *
+ * Singleton, all static class methods.
+ */
+class RadioBufferPool {
+public:
+	// At most 32 (free mask is one word)
+	static const unsigned int BufferCount = 8;
+	// S0, LENGTH, S1 bytes and 255 byte payload, rounded up to word
+	static const unsigned int BufferSize = 260;
+
+	/*
+	 * Returns buffer owned by App, or nullptr if none free.
+	 */
+	static RadioBufferPointer allocate();
+	static void release(const RadioBufferPointer buffer);
+
+	static void transferToRadioTX(const RadioBufferPointer buffer);
+	static void transferToRadioRX(const RadioBufferPointer buffer);
+	// From radio (after END or DISABLED) back to app
+	static void transferToApp(const RadioBufferPointer buffer);
+
+	static RadioBufferOwner owner(const RadioBufferPointer buffer);
+	static bool isPoolBuffer(const RadioBufferPointer buffer);
+	static unsigned int freeCount();
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * Value type: the whole configuration of the radio, as register words.
+ *
+ * Configuration is lost when radio POWER is toggled.
+ * Apply it in one pass with RadioDevice::applyConfiguration().
+ *
+ * Fields are the register values, not platform independent values.
+ * See RadioDevice::configure...() for meaning, or build one with snapshotConfiguration() after configuring field by field.
+ *
+ * modeConfig (MODECNF0) is ignored on nrf51.
+ */
+struct RadioConfig {
+	uint32_t frequency;
+	uint32_t mode;
+	uint32_t packetConfig0;	// PCNF0
+	uint32_t packetConfig1;	// PCNF1
+	uint32_t crcConfig;	// CRCCNF
+	uint32_t crcInit;
+	uint32_t crcPoly;
+	uint32_t base0;
+	uint32_t base1;
+	uint32_t prefix0;
+	uint32_t prefix1;
+	uint32_t txAddress;
+	uint32_t rxAddresses;
+	uint32_t txPower;
+	uint32_t shortcuts;	// SHORTS
+	uint32_t modeConfig;	// MODECNF0
+	uint32_t whiteningSeed;	// DATAWHITEIV
+};
@@ -0,0 +1,144 @@
+#include <cassert>
+
+#include "nrf.h"
+
+#include "radio.h"
+#include "radioConfig.h"
+#include "../mcu.h"
+
+
+/*
+ * Shadow of radio configuration registers.
+ *
+ * Radio configuration is lost on powerOff/powerOn.
+ * Reconfiguring field by field on every wake costs awake time,
+ * so applyConfiguration() writes only registers whose value differs from the shadow,
+ * and flushes the write buffer once.
+ *
+ * After powerOff, registers will be in reset state on powerOn, so shadow is reset values,
+ * and registers whose configured value equals reset value are never written.
+ *
+ * Every other RadioDevice method that writes a shadowed register (configure...(), setShortcuts(), ...)
+ * invalidates the shadow, so the next applyConfiguration() writes all registers.
+ * Code writing those registers directly (not through RadioDevice) must call invalidateConfigurationShadow().
+ */
+
+namespace {
+
+/*
+ * Reset values from Nordic product specification.
+ */
+const RadioConfig ResetConfiguration = {
+		0x00000002,	// FREQUENCY
+		0,	// MODE Nrf_1Mbit
+		0,	// PCNF0
+		0,	// PCNF1
+		0,	// CRCCNF
+		0,	// CRCINIT
+		0,	// CRCPOLY
+		0,	// BASE0
+		0,	// BASE1
+		0,	// PREFIX0
+		0,	// PREFIX1
+		0,	// TXADDRESS
+		0,	// RXADDRESSES
+		0,	// TXPOWER 0dBm
+		0,	// SHORTS
+		0x00000200,	// MODECNF0 DTX Center
+		0x00000040	// DATAWHITEIV
+};
+
+RadioConfig shadow;
+bool isShadowValid = false;
+
+
+void applyRegister(volatile uint32_t& hwRegister, uint32_t& shadowValue, const uint32_t value) {
+	if (!isShadowValid or shadowValue != value) {
+		hwRegister = value;
+		shadowValue = value;
+	}
+}
+
+}  // namespace
+
+
+
+void RadioDevice::applyConfiguration(const RadioConfig& config) {
+	/*
+	 * Many registers must not be written while radio is active.
+	 */
+	assert(isPowerOn());
+	assert(isDisabledState());
+
+	applyRegister(NRF_RADIO->FREQUENCY, shadow.frequency, config.frequency);
+	applyRegister(NRF_RADIO->MODE, shadow.mode, config.mode);
+	applyRegister(NRF_RADIO->PCNF0, shadow.packetConfig0, config.packetConfig0);
+	applyRegister(NRF_RADIO->PCNF1, shadow.packetConfig1, config.packetConfig1);
+	applyRegister(NRF_RADIO->CRCCNF, shadow.crcConfig, config.crcConfig);
+	applyRegister(NRF_RADIO->CRCINIT, shadow.crcInit, config.crcInit);
+	applyRegister(NRF_RADIO->CRCPOLY, shadow.crcPoly, config.crcPoly);
+	applyRegister(NRF_RADIO->BASE0, shadow.base0, config.base0);
+	applyRegister(NRF_RADIO->BASE1, shadow.base1, config.base1);
+	applyRegister(NRF_RADIO->PREFIX0, shadow.prefix0, config.prefix0);
+	applyRegister(NRF_RADIO->PREFIX1, shadow.prefix1, config.prefix1);
+	applyRegister(NRF_RADIO->TXADDRESS, shadow.txAddress, config.txAddress);
+	applyRegister(NRF_RADIO->RXADDRESSES, shadow.rxAddresses, config.rxAddresses);
+	applyRegister(NRF_RADIO->TXPOWER, shadow.txPower, config.txPower);
+	applyRegister(NRF_RADIO->SHORTS, shadow.shortcuts, config.shortcuts);
+#ifdef NRF52_SERIES
+	applyRegister(NRF_RADIO->MODECNF0, shadow.modeConfig, config.modeConfig);
+#endif
+	applyRegister(NRF_RADIO->DATAWHITEIV, shadow.whiteningSeed, config.whiteningSeed);
+
+	isShadowValid = true;
+
+	// Once for all writes
+	MCU::flushWriteCache();
+}
+
+
+/*
+ * Read registers.  Also makes shadow coherent with registers.
+ */
+void RadioDevice::snapshotConfiguration(RadioConfig& config) {
+	assert(isPowerOn());
+
+	config.frequency = NRF_RADIO->FREQUENCY;
+	config.mode = NRF_RADIO->MODE;
+	config.packetConfig0 = NRF_RADIO->PCNF0;
+	config.packetConfig1 = NRF_RADIO->PCNF1;
+	config.crcConfig = NRF_RADIO->CRCCNF;
+	config.crcInit = NRF_RADIO->CRCINIT;
+	config.crcPoly = NRF_RADIO->CRCPOLY;
+	config.base0 = NRF_RADIO->BASE0;
+	config.base1 = NRF_RADIO->BASE1;
+	config.prefix0 = NRF_RADIO->PREFIX0;
+	config.prefix1 = NRF_RADIO->PREFIX1;
+	config.txAddress = NRF_RADIO->TXADDRESS;
+	config.rxAddresses = NRF_RADIO->RXADDRESSES;
+	config.txPower = NRF_RADIO->TXPOWER;
+	config.shortcuts = NRF_RADIO->SHORTS;
+#ifdef NRF52_SERIES
+	config.modeConfig = NRF_RADIO->MODECNF0;
+#else
+	config.modeConfig = ResetConfiguration.modeConfig;
+#endif
+	// Bit 6 always reads one
+	config.whiteningSeed = NRF_RADIO->DATAWHITEIV;
+
+	shadow = config;
+	isShadowValid = true;
+}
+
+
+void RadioDevice::invalidateConfigurationShadow() {
+	isShadowValid = false;
+}
+
+/*
+ * Registers will be reset values on next powerOn.
+ */
+void RadioDevice::resetConfigurationShadow() {
+	shadow = ResetConfiguration;
+	isShadowValid = true;
+}
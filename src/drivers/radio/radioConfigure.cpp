@@ -3,6 +3,8 @@
 #include "nrf.h"
 
 #include "radio.h"
+#include "radioModes.h"
+#include "dynamicPacket.h"
 
 /*
  * Device level configuration
@@ -15,24 +17,32 @@
 
 // TODO rename channel
 void RadioDevice::configureFixedFrequency(uint8_t frequencyIndex){
+	invalidateConfigurationShadow();
 	// FUTURE: parameter
 	NRF_RADIO->FREQUENCY = frequencyIndex;
 }
 
 uint32_t RadioDevice::frequency(){ return NRF_RADIO->FREQUENCY; }
 
+void RadioDevice::restoreFrequency(uint32_t frequencyRegister) {
+	invalidateConfigurationShadow();
+	NRF_RADIO->FREQUENCY = frequencyRegister;
+}
+
 
 void RadioDevice::configureWhiteningSeed(int value){
+	invalidateConfigurationShadow();
 	/*
-	 * Only 5 bits (2^6-1 == 31).
+	 * Only 6 bits (2^6-1 == 63), e.g. BLE channel index 0..39.
 	 * Bit 6 cannot be written to 0 (always reads 1).
 	 */
-	assert(value < 31);
+	assert(value >= 0 && value < 64);
 	NRF_RADIO->DATAWHITEIV = value & RADIO_DATAWHITEIV_DATAWHITEIV_Msk;
 	// Whitening enabled elsewhere
 }
 
 void RadioDevice::configureWhiteningOn() {
+	invalidateConfigurationShadow();
 	// !!! Must not destroy contents of PCNF1, configured previously
 	// Configuring packet format later destroys this.
 	NRF_RADIO->PCNF1 = NRF_RADIO->PCNF1		// Bit set
@@ -53,27 +63,37 @@ void RadioDevice::configureWhiteningOn() {
  *
  * Only needs to be configured once.
  */
+namespace {
+#ifdef NRF52_SERIES
+const uint32_t preambleMask = RADIO_PCNF0_PLEN_Msk;
+#else
+const uint32_t preambleMask = 0;
+#endif
+}  // namespace
+
 void RadioDevice::configureStaticPacketFormat(const uint8_t PayloadCount, const uint8_t AddressLength) {
 	configureStaticOnAirPacketFormat();
 	configureStaticPayloadFormat(PayloadCount, AddressLength);
 }
 
 void RadioDevice::configureStaticOnAirPacketFormat() {
+	invalidateConfigurationShadow();
 	// All done in bit-fields of PCNF0 register.
 
 	// Note this affects tx and rx.
 	// And it is symmetrical, i.e. xmit does not expect S0 exists in RAM if S
 
-	// Do nothing:
-	// Defaults to no S0, no LENGTH, no S1
+	// No S0, no LENGTH, no S1
 	// I.e. only xmit the payload, without xmit length
 	// And the memory format also has these fields (normally a byte) non-existant.
+	// Reset default, but a dynamic format (e.g. BLEBeacon) may have set them: clear them.
 
 	// RadioHead: NRF_RADIO->PCNF0 = ((8 << RADIO_PCNF0_LFLEN_Pos) ); // Length of LENGTH field in bits
 	// We are not xmitting LENGTH field.
 
-	// default preamble length.
+	// Keeps PLEN (preamble length) as set by configureMode(), as configureDynamicOnAirPacketFormat.
 	// Datasheet says preamble length always one byte??? Conflicts with register description.
+	NRF_RADIO->PCNF0 = NRF_RADIO->PCNF0 & preambleMask;
 }
 
 /*
@@ -82,6 +102,7 @@ void RadioDevice::configureStaticOnAirPacketFormat() {
  * rcv PayloadCount (and truncate excess)
  */
 void RadioDevice::configureStaticPayloadFormat(const uint8_t payloadCount, const uint8_t addressLength) {
+	invalidateConfigurationShadow();
 
 	// We don't use a mask when bit-oring regs, we assert parameters are not too large
 	// assert(payloadCount<256);	// uint8_t guarantees this
@@ -112,6 +133,60 @@ void RadioDevice::configureStaticPayloadFormat(const uint8_t payloadCount, const
 
 
 
+/*
+ * Dynamic:
+ * LENGTH transmitted, so receiver learns payload count from packet.
+ * S0, S1 transmitted if format has them.
+ * On-air time is proportional to actual payload, not max payload.
+ *
+ * See DynamicPacket for the in-memory header.
+ */
+void RadioDevice::configureDynamicPacketFormat(const DynamicPacketFormat& format, const uint8_t maxPayloadCount, const uint8_t addressLength) {
+	configureDynamicOnAirPacketFormat(format);
+	configureDynamicPayloadFormat(maxPayloadCount, addressLength);
+}
+
+void RadioDevice::configureDynamicOnAirPacketFormat(const DynamicPacketFormat& format) {
+	invalidateConfigurationShadow();
+	assert(format.s0Bytes <= 1);
+	assert(format.lengthBits >= 1 && format.lengthBits <= 8);
+	assert(format.s1Bits <= 8);
+
+	// Also sets to zero: S1INCL.  Keeps PLEN (preamble length) as set by configureMode()
+	NRF_RADIO->PCNF0 =
+			  (NRF_RADIO->PCNF0 & preambleMask)
+			| (format.lengthBits << RADIO_PCNF0_LFLEN_Pos)	// bits
+			| (format.s0Bytes << RADIO_PCNF0_S0LEN_Pos)		// bytes
+			| (format.s1Bits << RADIO_PCNF0_S1LEN_Pos);		// bits
+}
+
+/*
+ * STATLEN zero: payload is exactly LENGTH bytes.
+ * MAXLEN: receiver truncates longer payloads (and CRC fails.)
+ */
+void RadioDevice::configureDynamicPayloadFormat(const uint8_t maxPayloadCount, const uint8_t addressLength) {
+	invalidateConfigurationShadow();
+	assert(addressLength >= 2);
+	assert(addressLength <= 5);
+	NRF_RADIO->PCNF1 =
+			  (maxPayloadCount << RADIO_PCNF1_MAXLEN_Pos)
+			| (0 << RADIO_PCNF1_STATLEN_Pos)
+			| ((addressLength-1) << RADIO_PCNF1_BALEN_Pos);
+	// Like configureStaticPayloadFormat, destroys whitening and endianess
+}
+
+
+void RadioDevice::configurePacketLengthDynamic(uint8_t maxPayloadCount) {
+	invalidateConfigurationShadow();
+	DynamicPacketFormat format = { 0, 8, 0 };
+	configureDynamicOnAirPacketFormat(format);
+
+	// Keep other bit-fields (BALEN, WHITEEN, ENDIAN)
+	NRF_RADIO->PCNF1 = (NRF_RADIO->PCNF1 & ~(RADIO_PCNF1_MAXLEN_Msk | RADIO_PCNF1_STATLEN_Msk))
+			| (maxPayloadCount << RADIO_PCNF1_MAXLEN_Pos);
+}
+
+
 /*
  *  Give radio pointer to buffer (for packet) in memory.
  *  Pointer must fit in 4 byte register.
@@ -135,12 +210,23 @@ void RadioDevice::configurePacketAddress(const RadioBufferPointer bufferPtr){
 	 */
 	assert(isPowerOn());
 	assert(isDisabledState());
-	NRF_RADIO->PACKETPTR = reinterpret_cast<uint32_t>( bufferPtr);
-	assert(reinterpret_cast<RadioBufferPointer>(NRF_RADIO->PACKETPTR) ==  bufferPtr);
+	NRF_RADIO->PACKETPTR = reinterpret_cast<uintptr_t>( bufferPtr);
+	assert(reinterpret_cast<RadioBufferPointer>((uintptr_t) NRF_RADIO->PACKETPTR) ==  bufferPtr);
+}
+
+/*
+ * PACKETPTR is double buffered: the radio latches it on START.
+ * So after the ADDRESS event (current packet already latched)
+ * it is safe to write the pointer for the next packet while radio is in RX or TX.
+ */
+void RadioDevice::configureNextPacketAddress(const RadioBufferPointer bufferPtr){
+	assert(isPowerOn());
+	NRF_RADIO->PACKETPTR = reinterpret_cast<uintptr_t>( bufferPtr);
 }
 
 
 void RadioDevice::configureXmitPower(int8_t powerValue) {
+	invalidateConfigurationShadow();
 	/*
 	 * value must be one of defined constants for the HW
 	 *
@@ -172,18 +258,23 @@ int8_t RadioDevice::getXmitPower() {
 
 // Nordic calls it MODE
 // Defaults on reset to 1M
-// Here omitting certain values (250k) the device supports.
+// Proprietary modes 1 and 2 Mbit only.  For other modes, see configureMode().
 void RadioDevice::configureMegaBitrate(unsigned int baud) {
-	int8_t value;
-		switch(baud) {
-		case 1:
-			value = RADIO_MODE_MODE_Nrf_1Mbit;
-			break;
-		case 2:
-		default:
-			value = RADIO_MODE_MODE_Nrf_2Mbit;
-		}
-		NRF_RADIO->MODE = value;
+	assert(baud == 1 || baud == 2);
+	configureMode(baud == 1 ? RadioMode::Nrf1Mbit : RadioMode::Nrf2Mbit);
+}
+
+/*
+ * Also sets preamble length the mode requires (PLEN, nrf52.)
+ * Packet format configured later keeps it.
+ */
+void RadioDevice::configureMode(RadioMode mode) {
+	invalidateConfigurationShadow();
+	NRF_RADIO->MODE = RadioModes::modeValue(mode);
+#ifdef NRF52_SERIES
+	const uint32_t preamble = RadioModes::preambleBits(mode) == 16 ? RADIO_PCNF0_PLEN_16bit : RADIO_PCNF0_PLEN_8bit;
+	NRF_RADIO->PCNF0 = (NRF_RADIO->PCNF0 & ~RADIO_PCNF0_PLEN_Msk) | (preamble << RADIO_PCNF0_PLEN_Pos);
+#endif
 }
 
 
@@ -191,6 +282,7 @@ void RadioDevice::configureMegaBitrate(unsigned int baud) {
  * Reduces rampup from 140uSec (nrf51) to 40uSec.
  */
 void RadioDevice::configureFastRampUp() {
+	invalidateConfigurationShadow();
 #ifdef NRF52_SERIES
 	NRF_RADIO->MODECNF0 = RADIO_MODECNF0_RU_Fast;
 	// Not a bitset: alters other fields of the register.
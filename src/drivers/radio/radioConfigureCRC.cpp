@@ -12,6 +12,7 @@
  * Fixed payload of 10 bytes plus 3 bytes address yields 13 bytes or 104 bits
  */
 void RadioDevice::configureMediumCRC() {
+	invalidateConfigurationShadow();
 	// CRC appropriate to data length about 120 bits: shorter, and better polynomial
 
 	// This defines:
@@ -38,6 +39,7 @@ void RadioDevice::configureShortCRC() {
 
 
 void RadioDevice::configureShortCRCLength() {
+	invalidateConfigurationShadow();
 	// This defines:
 	// - which MSB bit of generator is fed back (bit 8, 16, or 24)????
 	// - how many bytes of calculated CRC are transmitted.
@@ -45,6 +47,7 @@ void RadioDevice::configureShortCRCLength() {
 }
 
 void RadioDevice::configureShortCRCGeneratorInit(){
+	invalidateConfigurationShadow();
 	// The generator is at most 3 bytes long.
 	// CRCCNF_LEN defines which MSB bit is fed back, so the initial value can be 3 bytes
 	// even if the CRC length is less???
@@ -53,6 +56,7 @@ void RadioDevice::configureShortCRCGeneratorInit(){
 }
 
 void RadioDevice::configureShortCRCPolynomialForShortData() {
+	invalidateConfigurationShadow();
 	/*
 	 * Usually called C2, defined as 0x97 853210, but here 0x12F == 0x97 << 1
 	 * since on Nordic device, don't define bit 0.
@@ -61,3 +65,18 @@ void RadioDevice::configureShortCRCPolynomialForShortData() {
 	 */
 	NRF_RADIO->CRCPOLY = 0x12FUL;
 }
+
+
+/*
+ * CRC of Bluetooth LE (Core spec Vol 6 Part B 3.1.1.)
+ * Covers PDU only, not address.
+ * CRCINIT is 0x555555 on advertising channels; on data channels it is per connection.
+ */
+void RadioDevice::configureBLECRC() {
+	invalidateConfigurationShadow();
+	NRF_RADIO->CRCCNF = (RADIO_CRCCNF_LEN_Three << RADIO_CRCCNF_LEN_Pos)
+			| (RADIO_CRCCNF_SKIPADDR_Skip << RADIO_CRCCNF_SKIPADDR_Pos);
+	NRF_RADIO->CRCINIT = 0x555555UL;
+	// x^24 + x^10 + x^9 + x^6 + x^4 + x^3 + x + 1, without the x^24 term
+	NRF_RADIO->CRCPOLY = 0x00065BUL;
+}
@@ -0,0 +1,114 @@
+#include <cassert>
+
+#include "nrf.h"
+
+#include "radioEventDispatcher.h"
+#include "../mcu.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * Table is kept sorted by priority at registration, so the ISR only walks it.
+ * Events are identified in the ISR by their INTENSET mask bit.
+ * The ISR touches only events some handler wants: other events (and their interrupts) belong to someone else.
+ */
+
+namespace {
+
+struct HandlerEntry {
+	uint32_t eventMask;
+	VoidCallback handler;
+	uint8_t priority;
+};
+
+HandlerEntry handlers[RadioEventDispatcher::MaxHandlerCount];
+unsigned int count = 0;
+
+// Union of eventMask of all entries
+uint32_t handledMask = 0;
+
+
+uint32_t maskForEvent(RadioEvent event) {
+	uint32_t result;
+
+	switch(event) {
+	case RadioEvent::Ready:          result = RADIO_INTENSET_READY_Msk; break;
+	case RadioEvent::Address:        result = RADIO_INTENSET_ADDRESS_Msk; break;
+	case RadioEvent::End:            result = RADIO_INTENSET_END_Msk; break;
+	case RadioEvent::Disabled:       result = RADIO_INTENSET_DISABLED_Msk; break;
+	case RadioEvent::BitCounterMatch: result = RADIO_INTENSET_BCMATCH_Msk; break;
+	case RadioEvent::RSSISampleDone:
+	default:                         result = RADIO_INTENSET_RSSIEND_Msk; break;
+	}
+	return result;
+}
+
+}  // namespace
+
+
+
+void RadioEventDispatcher::registerHandler(RadioEvent event, VoidCallback handler, uint8_t priority) {
+	assert(handler != nullptr);
+	assert(count < MaxHandlerCount);
+
+	// Insertion: after all entries of same or higher priority
+	unsigned int index = count;
+	while (index > 0 && handlers[index - 1].priority > priority) {
+		handlers[index] = handlers[index - 1];
+		index--;
+	}
+	handlers[index].eventMask = maskForEvent(event);
+	handlers[index].handler = handler;
+	handlers[index].priority = priority;
+	count++;
+
+	handledMask |= handlers[index].eventMask;
+}
+
+void RadioEventDispatcher::unregisterAllHandlers() {
+	count = 0;
+	handledMask = 0;
+}
+
+unsigned int RadioEventDispatcher::handlerCount() { return count; }
+
+
+
+void RadioEventDispatcher::radioISR() {
+	const uint32_t candidates = NRF_RADIO->INTENSET & handledMask;
+	uint32_t pending = 0;
+
+	if ((candidates & RADIO_INTENSET_READY_Msk) && NRF_RADIO->EVENTS_READY) {
+		NRF_RADIO->EVENTS_READY = 0;
+		pending |= RADIO_INTENSET_READY_Msk;
+	}
+	if ((candidates & RADIO_INTENSET_ADDRESS_Msk) && NRF_RADIO->EVENTS_ADDRESS) {
+		NRF_RADIO->EVENTS_ADDRESS = 0;
+		pending |= RADIO_INTENSET_ADDRESS_Msk;
+	}
+	if ((candidates & RADIO_INTENSET_END_Msk) && NRF_RADIO->EVENTS_END) {
+		NRF_RADIO->EVENTS_END = 0;
+		pending |= RADIO_INTENSET_END_Msk;
+	}
+	if ((candidates & RADIO_INTENSET_DISABLED_Msk) && NRF_RADIO->EVENTS_DISABLED) {
+		NRF_RADIO->EVENTS_DISABLED = 0;
+		pending |= RADIO_INTENSET_DISABLED_Msk;
+	}
+	if ((candidates & RADIO_INTENSET_RSSIEND_Msk) && NRF_RADIO->EVENTS_RSSIEND) {
+		NRF_RADIO->EVENTS_RSSIEND = 0;
+		pending |= RADIO_INTENSET_RSSIEND_Msk;
+	}
+	if ((candidates & RADIO_INTENSET_BCMATCH_Msk) && NRF_RADIO->EVENTS_BCMATCH) {
+		NRF_RADIO->EVENTS_BCMATCH = 0;
+		pending |= RADIO_INTENSET_BCMATCH_Msk;
+	}
+	// One flush for all clears, before any handler can return from the ISR
+	MCU::flushWriteCache();
+
+	for (unsigned int i = 0; i < count && pending != 0; i++) {
+		if (handlers[i].eventMask & pending) {
+			handlers[i].handler();
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "../types.h"   // VoidCallback
+
+
+enum class RadioEvent { Ready, Address, End, Disabled, RSSISampleDone, BitCounterMatch };
+
+
+/*
+ * Table driven RADIO_IRQHandler.
+ *
+ * Instead of an app ISR testing each event predicate of RadioDevice,
+ * handlers are registered per event with a priority, and radioISR():
+ * - reads INTENSET once
+ * - reads each handled, enabled event once, clearing those set
+ * - flushes the write buffer once
+ * - calls handlers of set events, in priority order (lowest first; ties in order registered)
+ *
+ * Events are already cleared when a handler is called: the handler must not test them.
+ * The onXEvent() handlers of the engines (ContinuousReceiver, AutoAck, ChannelScanner, ...) are of this kind,
+ * e.g. registerHandler(RadioEvent::End, ContinuousReceiver::onEndEvent, 0).
+ *
+ * Only events whose interrupt is enabled are dispatched (and cleared.)
+ * Enabling the interrupts is still up to the engines.
+ *
+ * Singleton, all static class methods.
+ * Register while radio interrupt is disabled (table is not protected against the ISR.)
+ * !!! Caller must enable the radio IRQ in the NVIC and call radioISR() from RADIO_IRQHandler.
+ */
+class RadioEventDispatcher {
+public:
+	static const unsigned int MaxHandlerCount = 8;
+
+	static void registerHandler(RadioEvent event, VoidCallback handler, uint8_t priority);
+	static void unregisterAllHandlers();
+	static unsigned int handlerCount();
+
+	/*
+	 * Called by RADIO_IRQHandler.
+	 */
+	static void radioISR();
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "nrf.h"
+
+#include "types.h"	// RadioMode
+
+
+/*
+ * Constants per radio MODE, from the product specifications (nRF52832; nRF51 where it differs.)
+ *
+ * All constexpr, for use at compile time (see StaticRadioConfig, RadioAirtime.)
+ * A mode the chip family lacks is not an enumerator of RadioMode (see types.h), so using it fails to compile.
+ *
+ * Times in microseconds:
+ * - ramp up: TXEN or RXEN to READY
+ * - TX disable: DISABLE (or END->DISABLE) to DISABLED, from TX.  From RX it is negligible.
+ * - TX to RX turnaround: END of a transmitted packet to READY in RX, through DISABLED (shortcut DISABLED_RXEN.)
+ *   Same figure for RX to TX (RX disable is negligible, TX ramp up is the same.)
+ */
+namespace RadioModes {
+
+constexpr uint32_t modeValue(RadioMode mode) {
+	return mode == RadioMode::Nrf1Mbit ? RADIO_MODE_MODE_Nrf_1Mbit
+			: mode == RadioMode::Ble1Mbit ? RADIO_MODE_MODE_Ble_1Mbit
+#ifdef NRF52_SERIES
+			: mode == RadioMode::Ble2Mbit ? RADIO_MODE_MODE_Ble_2Mbit
+#endif
+#if defined(NRF51) || defined(NRF52832_XXAA)
+			: mode == RadioMode::Nrf250Kbit ? RADIO_MODE_MODE_Nrf_250Kbit
+#endif
+			: RADIO_MODE_MODE_Nrf_2Mbit;
+}
+
+/*
+ * Inverse of modeValue(), for code that decodes the MODE register (see RadioAirtime, the simulator.)
+ * A value the chip family lacks is taken as Nrf1Mbit.
+ */
+constexpr RadioMode modeOf(uint32_t value) {
+	return value == RADIO_MODE_MODE_Nrf_2Mbit ? RadioMode::Nrf2Mbit
+			: value == RADIO_MODE_MODE_Ble_1Mbit ? RadioMode::Ble1Mbit
+#ifdef NRF52_SERIES
+			: value == RADIO_MODE_MODE_Ble_2Mbit ? RadioMode::Ble2Mbit
+#endif
+#if defined(NRF51) || defined(NRF52832_XXAA)
+			: value == RADIO_MODE_MODE_Nrf_250Kbit ? RadioMode::Nrf250Kbit
+#endif
+			: RadioMode::Nrf1Mbit;
+}
+
+constexpr uint32_t kilobitsPerSecond(RadioMode mode) {
+	return mode == RadioMode::Nrf2Mbit ? 2000
+#ifdef NRF52_SERIES
+			: mode == RadioMode::Ble2Mbit ? 2000
+#endif
+#if defined(NRF51) || defined(NRF52832_XXAA)
+			: mode == RadioMode::Nrf250Kbit ? 250
+#endif
+			: 1000;
+}
+
+/*
+ * BLE 2M requires the 16-bit preamble (PCNF0.PLEN); other modes use 8 bits.
+ */
+constexpr uint32_t preambleBits(RadioMode mode) {
+#ifdef NRF52_SERIES
+	return mode == RadioMode::Ble2Mbit ? 16 : 8;
+#else
+	return 8;
+#endif
+}
+
+
+/*
+ * Same for all modes, Nrf_250Kbit included, on nrf51 as on nrf52 (specifications give one TXEN/RXEN time.)
+ * Fast ramp up (MODECNF0.RU) only on nrf52.
+ */
+constexpr uint32_t rampUpMicroseconds(RadioMode, bool isFastRampUp) {
+#ifdef NRF52_SERIES
+	return isFastRampUp ? 40 : 140;
+#else
+	return 140;
+#endif
+}
+
+/*
+ * Specification gives 6 at 1 Msps, 4 at 2 Msps.
+ * Not specified for Nrf_250Kbit: the 1 Msps figure.
+ */
+constexpr uint32_t txDisableMicroseconds(RadioMode mode) {
+	return kilobitsPerSecond(mode) == 2000 ? 4 : 6;
+}
+
+constexpr uint32_t turnaroundMicroseconds(RadioMode mode, bool isFastRampUp) {
+	return txDisableMicroseconds(mode) + rampUpMicroseconds(mode, isFastRampUp);
+}
+
+}  // namespace
@@ -0,0 +1,239 @@
+#include <cassert>
+
+#include "reassembler.h"
+#include "fragmentHeader.h"
+#include "dynamicPacket.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * A message is identified by (source, messageID): senders number their messages independently.
+ * Count of fragments is unknown until the Last fragment arrives: until then the message is incomplete.
+ * Use counter orders slots for eviction (least recently used incomplete) and delivery (oldest completed.)
+ */
+
+namespace {
+
+const DynamicPacketFormat Format = { 0, 8, 0 };
+
+enum class SlotState { Free, Assembling, Complete };
+
+struct Slot {
+	SlotState state;
+	uint8_t source;
+	uint8_t messageID;
+	uint8_t count;	// of fragments, zero until Last received
+	uint16_t length;	// known when Last received
+	uint64_t receivedMask;
+	uint32_t lastUsed;
+	uint8_t data[Reassembler::MaxMessageLength];
+};
+
+Slot slots[Reassembler::SlotCount];
+uint32_t useCount = 0;
+
+uint8_t payloadLength = 0;
+
+// Per source: most recently released message
+struct Released {
+	bool isKnown;
+	uint8_t messageID;
+};
+
+Released released[Reassembler::MaxSourceCount];
+
+// Of most recent fragment requesting ack
+uint8_t ackSourceAddress = 0;
+uint8_t ackMessageID = 0;
+uint64_t ackMask = 0;
+
+
+Slot* find(uint8_t source, uint8_t messageID) {
+	for (unsigned int i = 0; i < Reassembler::SlotCount; i++) {
+		if (slots[i].state != SlotState::Free && slots[i].source == source && slots[i].messageID == messageID) {
+			return &slots[i];
+		}
+	}
+	return nullptr;
+}
+
+/*
+ * Free slot, else least recently used Assembling slot, else none (all hold complete messages.)
+ */
+Slot* claim(uint8_t source, uint8_t messageID) {
+	Slot* victim = nullptr;
+
+	for (unsigned int i = 0; i < Reassembler::SlotCount; i++) {
+		if (slots[i].state == SlotState::Free) {
+			victim = &slots[i];
+			break;
+		}
+		if (slots[i].state == SlotState::Assembling
+				&& (victim == nullptr || slots[i].lastUsed < victim->lastUsed)) {
+			victim = &slots[i];
+		}
+	}
+	if (victim != nullptr) {
+		victim->state = SlotState::Assembling;
+		victim->source = source;
+		victim->messageID = messageID;
+		victim->count = 0;
+		victim->length = 0;
+		victim->receivedMask = 0;
+	}
+	return victim;
+}
+
+/*
+ * Returns false if fragment does not fit a slot (malformed, or sender configured differently.)
+ */
+bool store(Slot& slot, uint8_t flags, uint8_t index, const RadioBufferPointer data, uint8_t dataLength) {
+	const uint32_t offset = (uint32_t) index * payloadLength;
+	if (index >= FragmentHeader::MaxFragmentCount || offset + dataLength > Reassembler::MaxMessageLength) {
+		return false;
+	}
+	if (!(flags & FragmentHeader::Last) && dataLength != payloadLength) {
+		return false;
+	}
+
+	if (!(slot.receivedMask & (1ull << index))) {
+		for (unsigned int i = 0; i < dataLength; i++) {
+			slot.data[offset + i] = data[i];
+		}
+		slot.receivedMask |= 1ull << index;
+	}
+	if (flags & FragmentHeader::Last) {
+		slot.count = index + 1;
+		slot.length = offset + dataLength;
+	}
+	if (slot.count > 0 && slot.receivedMask == FragmentHeader::maskOfCount(slot.count)) {
+		slot.state = SlotState::Complete;
+	}
+	return true;
+}
+
+}  // namespace
+
+
+
+void Reassembler::configure(uint8_t aPayloadLength) {
+	assert(aPayloadLength > 0);
+	payloadLength = aPayloadLength;
+	reset();
+}
+
+void Reassembler::reset() {
+	for (unsigned int i = 0; i < SlotCount; i++) {
+		slots[i].state = SlotState::Free;
+	}
+	for (unsigned int i = 0; i < MaxSourceCount; i++) {
+		released[i].isKnown = false;
+	}
+	useCount = 0;
+}
+
+
+
+bool Reassembler::onFragment(const RadioBufferPointer packet, uint8_t source) {
+	assert(payloadLength > 0);
+	assert(source < MaxSourceCount);
+
+	DynamicPacket view(packet, Format);
+	if (view.length() < FragmentHeader::FragmentHeaderLength) {
+		return false;
+	}
+	RadioBufferPointer payload = view.payload();
+	const uint8_t flags = payload[0] & FragmentHeader::FlagsMask;
+	const uint8_t messageID = payload[0] & FragmentHeader::MessageIDMask;
+	const uint8_t index = payload[1];
+	if (flags & FragmentHeader::Ack) {
+		return false;
+	}
+
+	Released& sourceReleased = released[source];
+	if (sourceReleased.isKnown && messageID != sourceReleased.messageID) {
+		// This sender moved on, so it got our final ack: the ID may be reused for a new message
+		sourceReleased.isKnown = false;
+	}
+
+	uint64_t mask;
+	if (sourceReleased.isKnown && messageID == sourceReleased.messageID && find(source, messageID) == nullptr) {
+		// Sender missed our final ack
+		mask = ~0ull;
+	}
+	else {
+		Slot* slot = find(source, messageID);
+		if (slot == nullptr) {
+			slot = claim(source, messageID);
+		}
+		if (slot == nullptr) {
+			// No room: no ack, sender will probe again
+			return false;
+		}
+		slot->lastUsed = ++useCount;
+		if (slot->state == SlotState::Assembling) {
+			store(*slot, flags, index,
+					payload + FragmentHeader::FragmentHeaderLength,
+					view.length() - FragmentHeader::FragmentHeaderLength);
+		}
+		mask = slot->receivedMask;
+	}
+
+	if (flags & FragmentHeader::AckRequest) {
+		ackSourceAddress = source;
+		ackMessageID = messageID;
+		ackMask = mask;
+		return true;
+	}
+	return false;
+}
+
+
+void Reassembler::buildAck(RadioBufferPointer ackPacket) {
+	DynamicPacket view(ackPacket, Format);
+	RadioBufferPointer payload = view.payload();
+
+	payload[0] = FragmentHeader::Ack | ackMessageID;
+	FragmentHeader::writeMask(payload + 1, ackMask);
+	view.setLength(FragmentHeader::AckLength);
+}
+
+uint8_t Reassembler::ackSource() { return ackSourceAddress; }
+
+
+
+const uint8_t* Reassembler::completedMessage(uint16_t& length, uint8_t& messageID, uint8_t& source) {
+	Slot* oldest = nullptr;
+
+	for (unsigned int i = 0; i < SlotCount; i++) {
+		if (slots[i].state == SlotState::Complete
+				&& (oldest == nullptr || slots[i].lastUsed < oldest->lastUsed)) {
+			oldest = &slots[i];
+		}
+	}
+	if (oldest == nullptr) {
+		return nullptr;
+	}
+	length = oldest->length;
+	messageID = oldest->messageID;
+	source = oldest->source;
+	return oldest->data;
+}
+
+
+void Reassembler::releaseCompletedMessage() {
+	uint16_t length;
+	uint8_t messageID;
+	uint8_t source;
+	const uint8_t* data = completedMessage(length, messageID, source);
+	assert(data != nullptr);
+
+	for (unsigned int i = 0; i < SlotCount; i++) {
+		if (slots[i].data == data) {
+			slots[i].state = SlotState::Free;
+		}
+	}
+	released[source].isKnown = true;
+	released[source].messageID = messageID;
+}
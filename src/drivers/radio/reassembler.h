@@ -0,0 +1,64 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+
+
+/*
+ * Receiver side of fragmentation: reassembles messages from fragments (see Fragmenter, FragmentHeader.)
+ *
+ * Fixed slots (no heap): each slot holds one message of at most MaxMessageLength, assembled in place
+ * (fragment i at offset i * fragmentPayloadLength.)
+ * Fragments may arrive in any order, duplicates are ignored.
+ * Several senders may send at once: a message is identified by its source (the logical address it was
+ * received on, RXMATCH, one per sender) and its messageID, since each sender numbers its messages from its own count.
+ * When all slots are busy, a fragment of a new message evicts the least recently used incomplete message.
+ * A complete message stays in its slot until the app releases it.
+ *
+ * Acks: a fragment requesting an ack makes onFragment() return true;
+ * the app then transmits buildAck() promptly (within the sender's ack window, see ReceiveWindow.)
+ * The ack is the mask of all fragments received of that message.
+ * Per source, fragments of the most recently released message are acked (all received) but not assembled again,
+ * in case the sender missed the final ack, until a fragment of another message from the same source arrives.
+ * Then that sender has moved on: a later message reusing the ID (IDs wrap) is assembled as new.
+ *
+ * Receive fragments e.g. with ContinuousReceiver, passing each buffer (CRC valid only)
+ * and completedBufferLogicalAddress() to onFragment().
+ *
+ * Singleton, all static class methods.
+ * Not for concurrent use from ISR and app: call from one context.
+ */
+class Reassembler {
+public:
+	static const unsigned int SlotCount = 2;
+	static const unsigned int MaxMessageLength = 2048;
+	// Logical addresses
+	static const unsigned int MaxSourceCount = 8;
+
+	/*
+	 * Same fragmentPayloadLength as the sender's.
+	 */
+	static void configure(uint8_t fragmentPayloadLength);
+	static void reset();
+
+	/*
+	 * packet as received (dynamic format, 8-bit LENGTH, no S0, S1.)
+	 * source is the logical address it was received on (RXMATCH.)
+	 * Returns true if the sender awaits an ack.
+	 */
+	static bool onFragment(const RadioBufferPointer packet, uint8_t source);
+	/*
+	 * Ack for the fragment most recently passed to onFragment() that requested one.
+	 * ackPacket is a TX buffer of at least 1 + FragmentHeader::AckLength bytes.
+	 */
+	static void buildAck(RadioBufferPointer ackPacket);
+	// Source of that fragment: the sender to ack
+	static uint8_t ackSource();
+
+	/*
+	 * A complete message, or nullptr.  Oldest completed first.
+	 */
+	static const uint8_t* completedMessage(uint16_t& length, uint8_t& messageID, uint8_t& source);
+	static void releaseCompletedMessage();
+};
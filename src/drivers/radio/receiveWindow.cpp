@@ -0,0 +1,74 @@
+#include <cassert>
+
+#include "receiveWindow.h"
+#include "radio.h"
+
+#include "../clock/counter.h"
+#include "../eventToTaskSignal.h"
+#include "../hwConfig.h"
+
+
+/*
+ * Implementation notes:
+ *
+ * RadioWindowExtendPPIChannel is always-on while armed (not one-shot): it only disarms, so firing twice is harmless.
+ * A compare that fires after ADDRESS finds its channel disarmed.
+ * A compare that fires before ADDRESS closes the window, as it should.
+ */
+
+namespace {
+
+const CompareRegister* windowRegister = nullptr;
+uint32_t windowTicks = 0;
+
+}  // namespace
+
+
+
+void ReceiveWindow::configure(const CompareRegister& compareRegister, const uint32_t aWindowTicks) {
+	assert(aWindowTicks >= 2);
+	windowRegister = &compareRegister;
+	windowTicks = aWindowTicks;
+}
+
+
+/*
+ * Counter is 24-bit
+ */
+void ReceiveWindow::arm() {
+	assert(windowRegister != nullptr);
+
+	// No signal while changing compare value
+	windowRegister->disableEventSignal();
+	windowRegister->set((Counter::ticks() + windowTicks) & 0xFFFFFF);
+	EventToTaskSignal::connectOneShot(
+			RadioWindowPPIChannel,
+			windowRegister->getEventRegisterAddress(),
+			RadioDevice::getDisableTaskRegisterAddress());
+	EventToTaskSignal::connect(
+			RadioWindowExtendPPIChannel,
+			RadioDevice::getAddressEventRegisterAddress(),
+			EventToTaskSignal::getDisarmTaskAddress(RadioWindowPPIChannel));
+	windowRegister->enableEventSignal();
+}
+
+void ReceiveWindow::disarm() {
+	assert(windowRegister != nullptr);
+
+	windowRegister->disableEventSignal();
+	EventToTaskSignal::disconnect(RadioWindowPPIChannel);
+	EventToTaskSignal::disconnect(RadioWindowExtendPPIChannel);
+}
+
+
+
+void ReceiveWindow::receive(RadioBufferPointer buffer) {
+	RadioDevice::configurePacketAddress(buffer);
+	RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+	RadioDevice::clearEndEvent();
+	RadioDevice::clearDisabledEvent();
+	RadioDevice::startRXTask();
+	arm();
+}
+
+bool ReceiveWindow::isPacketReceived() { return RadioDevice::isEndEvent(); }
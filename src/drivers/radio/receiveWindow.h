@@ -0,0 +1,52 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "types.h"	// RadioBufferPointer
+#include "../clock/compareRegister.h"
+
+
+/*
+ * Receive window closed in hardware: the cpu can sleep through an empty window.
+ *
+ * RTC compare event -> PPI (one-shot, RadioWindowPPIChannel) -> RADIO TASKS_DISABLE.
+ * RADIO ADDRESS event -> PPI (RadioWindowExtendPPIChannel) -> disarm the one-shot.
+ * So a packet in flight when the window would close is received whole:
+ * the window extends to the packet's END (then END->DISABLE shortcut.)
+ *
+ * Either way the radio ends DISABLED: one DISABLED interrupt (one wake) per window, packet or not.
+ *
+ * Uses PPI channels RadioWindowPPIChannel and RadioWindowExtendPPIChannel in hwConfig.h.
+ * AutoAck uses it for its ack window, so not both at once.
+ *
+ * Singleton, all static class methods.
+ */
+class ReceiveWindow {
+public:
+	/*
+	 * Window length in ticks of Counter.
+	 * Must cover ramp-up (at least 2 ticks, per RTC.)
+	 */
+	static void configure(const CompareRegister&, const uint32_t windowTicks);
+
+	/*
+	 * Close the window windowTicks from now, unless an ADDRESS event comes first.
+	 * Radio already in (or ramping up to) RX, with shortcuts that end in DISABLED after a packet.
+	 */
+	static void arm();
+	// Disarm if not fired.  Does not disable the radio.
+	static void disarm();
+
+	/*
+	 * Receive one packet (SinglePacket shortcuts) into buffer, or none in the window.
+	 * Radio configured and DISABLED.
+	 * Caller enables the DISABLED interrupt (or polls isDisabledState), then calls isPacketReceived() and disarm().
+	 */
+	static void receive(RadioBufferPointer buffer);
+
+	/*
+	 * After DISABLED: whether a packet ended (END) rather than the window closing empty.
+	 * CRC not checked: see RadioDevice::isCRCValid().
+	 */
+	static bool isPacketReceived();
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "nrf.h"
+
+#include "radio.h"
+#include "radioConfig.h"
+#include "radioModes.h"
+#include "types.h"	// RadioMode
+#include "../mcu.h"
+
+
+/*
+ * Compile time radio configuration.
+ *
+ * Same configuration as the configure...() methods, for a static packet format and logical address 0,
+ * but arguments are template parameters validated by static_assert, so an illegal configuration fails to compile.
+ * Register words are computed at compile time.
+ * apply() is a sequence of stores with no branches and no asserts.
+ *
+ * Example:
+ * typedef StaticRadioConfig<2, RadioMode::Nrf2Mbit, 0, 10, 4, 0xE7E7E7E7, 0xE7, 1, 0x25, true> MyRadioConfig;
+ * MyRadioConfig::apply();
+ */
+
+namespace StaticRadioRules {
+
+constexpr bool isLegalFrequency(unsigned int index) { return index <= 100; }
+
+#ifdef NRF52_SERIES
+constexpr bool isLegalTxPower(int dBm) {
+	return dBm == 4 or dBm == 3 or dBm == 0 or dBm == -4 or dBm == -8
+			or dBm == -12 or dBm == -16 or dBm == -20 or dBm == -40;
+}
+#else
+constexpr bool isLegalTxPower(int dBm) {
+	return dBm == 4 or dBm == 0 or dBm == -4 or dBm == -8
+			or dBm == -12 or dBm == -16 or dBm == -20 or dBm == -30;
+}
+#endif
+
+// Nordic docs disallow 2 but others have reported it works (see configureStaticPayloadFormat)
+constexpr bool isLegalAddressLength(unsigned int length) { return length >= 2 and length <= 5; }
+
+/*
+ * First transmitted byte of address is LSByte of truncated base (base is truncated from LSByte.)
+ * Should not be one of four outlawed values: too few bit transitions to follow preamble.
+ */
+constexpr bool isLegalFirstAddressByte(uint8_t value) {
+	return value != 0x00 and value != 0xFF and value != 0x55 and value != 0xAA;
+}
+constexpr uint8_t firstTransmittedBaseByte(uint32_t base, unsigned int addressLength) {
+	return (uint8_t) (base >> (8 * (4 - (addressLength - 1))));
+}
+
+constexpr bool isLegalCRCLength(unsigned int length) { return length <= 3; }
+
+/*
+ * Only bits 0..5 are writeable, bit 6 always one.
+ * Negative means whitening off.
+ */
+constexpr bool isLegalWhiteningSeed(int seed) { return seed < 64; }
+
+
+/*
+ * Register values.
+ */
+constexpr uint32_t modeValue(RadioMode mode) { return RadioModes::modeValue(mode); }
+
+#ifdef NRF52_SERIES
+constexpr uint32_t preambleValue(RadioMode mode) {
+	return (RadioModes::preambleBits(mode) == 16 ? RADIO_PCNF0_PLEN_16bit : RADIO_PCNF0_PLEN_8bit) << RADIO_PCNF0_PLEN_Pos;
+}
+#else
+constexpr uint32_t preambleValue(RadioMode) { return 0; }
+#endif
+
+/*
+ * Same choices as radioConfigureCRC.cpp.
+ * Three bytes is BLE (configureBLECRC): CRC skips the address.
+ */
+constexpr uint32_t crcConfigValue(unsigned int length) {
+	return (length << RADIO_CRCCNF_LEN_Pos)
+			| (length == 3 ? (RADIO_CRCCNF_SKIPADDR_Skip << RADIO_CRCCNF_SKIPADDR_Pos) : 0);
+}
+constexpr uint32_t crcPolyValue(unsigned int length) {
+	return length == 1 ? 0x12FUL : (length == 2 ? 0x11021UL : (length == 3 ? 0x65BUL : 0));
+}
+constexpr uint32_t crcInitValue(unsigned int length) {
+	return length == 1 ? 0xFFUL : (length == 2 ? 0xFFFFUL : (length == 3 ? 0x555555UL : 0));
+}
+
+}  // namespace
+
+
+
+template <
+	uint8_t FrequencyIndex,
+	RadioMode Mode,
+	int TxPowerDBm,
+	uint8_t PayloadCount,
+	uint8_t AddressLength,
+	uint32_t Base0,
+	uint8_t Prefix0,
+	uint8_t CRCLength,
+	int WhiteningSeed,	// negative for whitening off
+	bool IsFastRampUp
+>
+class StaticRadioConfig {
+	static_assert(StaticRadioRules::isLegalFrequency(FrequencyIndex), "Frequency index must be 0..100");
+	static_assert(StaticRadioRules::isLegalTxPower(TxPowerDBm), "TX power not supported by chip family");
+	static_assert(StaticRadioRules::isLegalAddressLength(AddressLength), "Address length must be 2..5");
+	static_assert(StaticRadioRules::isLegalFirstAddressByte(
+			StaticRadioRules::firstTransmittedBaseByte(Base0, AddressLength)),
+			"First transmitted address byte must not be 0x00, 0xFF, 0x55, 0xAA");
+	static_assert(StaticRadioRules::isLegalCRCLength(CRCLength), "CRC length must be 0..3");
+	static_assert(StaticRadioRules::isLegalWhiteningSeed(WhiteningSeed), "Whitening seed must be 0..63");
+#ifndef NRF52_SERIES
+	static_assert(!IsFastRampUp, "Fast ramp up requires nrf52");
+#endif
+
+public:
+	static constexpr RadioConfig configuration() {
+		return RadioConfig {
+			FrequencyIndex,
+			StaticRadioRules::modeValue(Mode),
+			StaticRadioRules::preambleValue(Mode),	// PCNF0: no S0, LENGTH, S1
+			(PayloadCount << RADIO_PCNF1_MAXLEN_Pos)
+				| (PayloadCount << RADIO_PCNF1_STATLEN_Pos)
+				| ((AddressLength - 1) << RADIO_PCNF1_BALEN_Pos)
+				| ((WhiteningSeed >= 0 ? 1 : 0) << RADIO_PCNF1_WHITEEN_Pos),
+			StaticRadioRules::crcConfigValue(CRCLength),
+			StaticRadioRules::crcInitValue(CRCLength),
+			StaticRadioRules::crcPolyValue(CRCLength),
+			Base0,
+			0,	// BASE1
+			(uint32_t) Prefix0 << RADIO_PREFIX0_AP0_Pos,
+			0,	// PREFIX1
+			0,	// TXADDRESS logical 0
+			0x01,	// RXADDRESSES logical 0
+			(uint8_t) TxPowerDBm,
+			// RadioShortcutProfile::SinglePacket
+			RADIO_SHORTS_READY_START_Msk | RADIO_SHORTS_END_DISABLE_Msk | RADIO_SHORTS_ADDRESS_RSSISTART_Msk,
+			(IsFastRampUp ? RADIO_MODECNF0_RU_Fast : 0) | (RADIO_MODECNF0_DTX_Center << RADIO_MODECNF0_DTX_Pos),
+			(uint32_t) (WhiteningSeed >= 0 ? WhiteningSeed : 0) | 0x40
+		};
+	}
+
+	// Compile time constant, apply() stores its fields
+	static constexpr RadioConfig Configuration = configuration();
+
+	/*
+	 * Unconditional stores of constants.
+	 * Radio must be powered on and DISABLED (not asserted.)
+	 */
+	static void apply() {
+		NRF_RADIO->FREQUENCY = Configuration.frequency;
+		NRF_RADIO->MODE = Configuration.mode;
+		NRF_RADIO->PCNF0 = Configuration.packetConfig0;
+		NRF_RADIO->PCNF1 = Configuration.packetConfig1;
+		NRF_RADIO->CRCCNF = Configuration.crcConfig;
+		NRF_RADIO->CRCINIT = Configuration.crcInit;
+		NRF_RADIO->CRCPOLY = Configuration.crcPoly;
+		NRF_RADIO->BASE0 = Configuration.base0;
+		NRF_RADIO->PREFIX0 = Configuration.prefix0;
+		NRF_RADIO->TXADDRESS = Configuration.txAddress;
+		NRF_RADIO->RXADDRESSES = Configuration.rxAddresses;
+		NRF_RADIO->TXPOWER = Configuration.txPower;
+		NRF_RADIO->SHORTS = Configuration.shortcuts;
+#ifdef NRF52_SERIES
+		NRF_RADIO->MODECNF0 = Configuration.modeConfig;
+#endif
+		NRF_RADIO->DATAWHITEIV = Configuration.whiteningSeed;
+		MCU::flushWriteCache();
+
+		// Registers no longer match shadow of applyConfiguration()
+		RadioDevice::invalidateConfigurationShadow();
+	}
+};
+
+// Definition (C++11: Configuration is odr-used by apply())
+template <uint8_t FrequencyIndex, RadioMode Mode, int TxPowerDBm, uint8_t PayloadCount, uint8_t AddressLength,
+		uint32_t Base0, uint8_t Prefix0, uint8_t CRCLength, int WhiteningSeed, bool IsFastRampUp>
+constexpr RadioConfig StaticRadioConfig<FrequencyIndex, Mode, TxPowerDBm, PayloadCount, AddressLength,
+		Base0, Prefix0, CRCLength, WhiteningSeed, IsFastRampUp>::Configuration;
@@ -0,0 +1,44 @@
+#include <cassert>
+
+#include "timedRadioTask.h"
+#include "radio.h"
+
+#include "../eventToTaskSignal.h"
+#include "../hwConfig.h"
+
+
+namespace {
+
+void armAtTick(const CompareRegister& compareRegister, const uint32_t tick, uint32_t* taskAddress) {
+	assert(RadioDevice::isDisabledState());
+
+	// No signal while changing compare value
+	compareRegister.disableEventSignal();
+	compareRegister.set(tick);
+
+	// One-shot: compare matches again after Counter rolls over, but channel has disabled itself
+	EventToTaskSignal::connectOneShot(
+			RadioTimedStartPPIChannel,
+			compareRegister.getEventRegisterAddress(),
+			taskAddress);
+
+	compareRegister.enableEventSignal();
+}
+
+}  // namespace
+
+
+
+void TimedRadioTask::transmitAtTick(const CompareRegister& compareRegister, const uint32_t tick) {
+	armAtTick(compareRegister, tick, RadioDevice::getTXEnableTaskRegisterAddress());
+}
+
+void TimedRadioTask::receiveAtTick(const CompareRegister& compareRegister, const uint32_t tick) {
+	armAtTick(compareRegister, tick, RadioDevice::getRXEnableTaskRegisterAddress());
+}
+
+
+void TimedRadioTask::cancel(const CompareRegister& compareRegister) {
+	compareRegister.disableEventSignal();
+	EventToTaskSignal::disconnect(RadioTimedStartPPIChannel);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "../clock/compareRegister.h"
+
+
+/*
+ * Start radio at an exact tick of the Counter (RTC), without cpu.
+ *
+ * RTC compare event -> PPI (one-shot channel) -> RADIO TASKS_TXEN or TASKS_RXEN.
+ * The cpu may sleep (MCU::sleepUntilEvent) right up to and through the slot.
+ *
+ * Radio must be fully configured (packet pointer, shortcuts, interrupts) and DISABLED before arming.
+ * From the task, radio ramps up (see configureFastRampUp) then starts as configured by shortcuts.
+ *
+ * Uses the PPI channel defined in hwConfig.h.
+ * Only one arming at a time: arming again replaces the previous.
+ *
+ * Singleton, all static class methods.
+ */
+class TimedRadioTask {
+public:
+	/*
+	 * tick is an alarm time on the circular Counter clock (24-bit.)
+	 * !!! tick must be at least 2 ticks after Counter::ticks(), else the RTC might not generate the event.
+	 */
+	static void transmitAtTick(const CompareRegister&, const uint32_t tick);
+	static void receiveAtTick(const CompareRegister&, const uint32_t tick);
+
+	/*
+	 * Disarm, if not already fired.
+	 * Does not disable radio if already fired.
+	 */
+	static void cancel(const CompareRegister&);
+};
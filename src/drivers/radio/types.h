@@ -1,3 +1,9 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "nrf.h"	// chip family, for RadioMode
+
 /*
  * Types used by radio driver
  */
@@ -12,3 +18,43 @@
  * I.E. there are two separate threads/processors accessing buffer.
  */
 typedef volatile uint8_t * RadioBufferPointer;
+
+
+/*
+ * Called with buffer of a received packet.
+ */
+typedef void (*ReceivedPacketCallback)(RadioBufferPointer);
+
+
+/*
+ * Named sets of shortcuts (automatic transitions in the radio state diagram.)
+ * See RadioDevice::setShortcuts()
+ */
+enum class RadioShortcutProfile {
+	None,			// every transition by explicit task
+	SinglePacket,		// one packet then DISABLED
+	ContinuousReceive,	// stay in RX between packets
+	TransmitThenReceive,	// one packet TX, then turnaround to RX (awaiting ack)
+	ReceiveThenTransmit,	// one packet RX, then turnaround to TX (sending ack)
+	TransmitBurst,		// packet after packet TX, through DISABLED (see BurstTransmitter)
+	SampleSignal		// RX started, for RSSI samples only (no logical address enabled)
+};
+
+
+/*
+ * Modulation and bitrate (Nordic calls it MODE.)
+ *
+ * Only the modes of the chip being built for: another mode fails to compile.
+ * See RadioModes for constants per mode.
+ */
+enum class RadioMode {
+	Nrf1Mbit,
+	Nrf2Mbit,
+	Ble1Mbit,	// BLE advertising and data channels (see BLEBeacon)
+#ifdef NRF52_SERIES
+	Ble2Mbit,	// bulk transfer: 16-bit preamble
+#endif
+#if defined(NRF51) || defined(NRF52832_XXAA)
+	Nrf250Kbit,	// range, for nodes at the edge.  Not on nRF52810, nRF52840
+#endif
+};
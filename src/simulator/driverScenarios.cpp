@@ -0,0 +1,456 @@
+#include <cassert>
+
+#include "driverScenarios.h"
+#include "virtualMedium.h"
+
+#include "radio/radio.h"
+#include "radio/continuousReceiver.h"
+#include "radio/burstTransmitter.h"
+#include "radio/earlyRejectFilter.h"
+#include "radio/dynamicPacket.h"
+#include "radio/channelScanner.h"
+
+
+namespace {
+
+const uint64_t NanosecondsPerMicrosecond = 1000;
+const uint8_t PayloadCount = 8;
+const uint8_t AddressLength = 4;
+const uint32_t MaxBurstPacketCount = 64;
+
+
+/*
+ * Same configuration on every node: static format, 2 Mbit, fast ramp up.
+ */
+void configureNode() {
+	RadioDevice::powerOn();
+	RadioDevice::configureFixedFrequency(2);
+	RadioDevice::configureFixedLogicalAddress();
+	RadioDevice::configureNetworkAddressPool();
+	RadioDevice::configureMediumCRC();
+	RadioDevice::configureStaticPacketFormat(PayloadCount, AddressLength);
+	RadioDevice::configureWhiteningOn();
+	RadioDevice::configureMegaBitrate(2);
+	RadioDevice::configureFastRampUp();
+}
+
+/*
+ * As configureNode(), but dynamic format: S0 byte, 8 bit LENGTH.
+ */
+const DynamicPacketFormat DynamicFormat = { 1, 8, 0 };
+const uint8_t MaxDynamicPayloadCount = 60;
+
+void configureDynamicNode() {
+	RadioDevice::powerOn();
+	RadioDevice::configureFixedFrequency(2);
+	RadioDevice::configureMediumCRC();
+	RadioDevice::configureDynamicPacketFormat(DynamicFormat, MaxDynamicPayloadCount, AddressLength);
+	RadioDevice::configureFixedLogicalAddress();
+	RadioDevice::configureNetworkAddressPool();
+	RadioDevice::configureMegaBitrate(2);
+	RadioDevice::configureFastRampUp();
+}
+
+/*
+ * Payload numbered by sequence, so the receiver can tell a packet from a stale buffer.
+ */
+void fillPacket(uint8_t* buffer, uint32_t sequence) {
+	for (unsigned int i = 0; i < PayloadCount; i++) {
+		buffer[i] = (uint8_t) (sequence * 7 + i);
+	}
+}
+
+bool isPacket(const volatile uint8_t* buffer, uint32_t sequence) {
+	for (unsigned int i = 0; i < PayloadCount; i++) {
+		if (buffer[i] != (uint8_t) (sequence * 7 + i)) return false;
+	}
+	return true;
+}
+
+
+/*
+ * App side of ContinuousReceiver: take completed buffers, expecting packets in sequence.
+ */
+void takeCompletedBuffers(uint32_t& receivedIntact, uint32_t& receivedOther, uint32_t& expectedSequence) {
+	while (ContinuousReceiver::isCompletedBuffer()) {
+		if (ContinuousReceiver::isCompletedBufferCRCValid()
+				&& isPacket(ContinuousReceiver::completedBuffer(), expectedSequence)) {
+			receivedIntact++;
+			expectedSequence++;
+		}
+		else {
+			receivedOther++;
+		}
+		ContinuousReceiver::releaseCompletedBuffer();
+	}
+}
+
+void startContinuousReceiver(VirtualRadio& receiver, uint8_t (*receiveBuffers)[PayloadCount], uint32_t interruptLatencyNanoseconds) {
+	VirtualRadio::Scope scope(receiver);
+	receiver.setInterruptHandler(ContinuousReceiver::radioISR);
+	receiver.setInterruptLatencyNanoseconds(interruptLatencyNanoseconds);
+	configureNode();
+	RadioBufferPointer buffers[ContinuousReceiver::MaxBufferCount];
+	for (unsigned int i = 0; i < ContinuousReceiver::MaxBufferCount; i++) {
+		buffers[i] = receiveBuffers[i];
+	}
+	ContinuousReceiver::configureBuffers(buffers, ContinuousReceiver::MaxBufferCount);
+	ContinuousReceiver::start();
+}
+
+}  // namespace
+
+
+
+ContinuousReceiveResult DriverScenarios::continuousReceiveZeroDrop(uint32_t packetCount, uint32_t interruptLatencyNanoseconds) {
+	const uint64_t PacketIntervalNanoseconds = 300 * NanosecondsPerMicrosecond;
+
+	ContinuousReceiveResult result = ContinuousReceiveResult();
+	VirtualMedium medium;
+	VirtualRadio& sender = medium.addNode(1);
+	VirtualRadio& receiver = medium.addNode(2);
+
+	uint8_t transmitBuffer[PayloadCount];
+	uint8_t receiveBuffers[ContinuousReceiver::MaxBufferCount][PayloadCount];
+	uint32_t expectedSequence = 0;
+
+	{
+		VirtualRadio::Scope scope(sender);
+		configureNode();
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+	}
+	startContinuousReceiver(receiver, receiveBuffers, interruptLatencyNanoseconds);
+
+	for (uint32_t sequence = 0; sequence < packetCount; sequence++) {
+		const uint64_t sendTime = (sequence + 1) * PacketIntervalNanoseconds;
+		medium.callAt(sendTime, sender, [&transmitBuffer, &result, sequence]() {
+			assert(RadioDevice::isDisabledState());
+			fillPacket(transmitBuffer, sequence);
+			RadioDevice::configurePacketAddress(transmitBuffer);
+			RadioDevice::startTXTask();
+			result.sent++;
+		});
+		// App takes buffers midway between packets
+		medium.callAt(sendTime + PacketIntervalNanoseconds / 2, receiver, [&result, &expectedSequence]() {
+			takeCompletedBuffers(result.receivedIntact, result.receivedOther, expectedSequence);
+		});
+	}
+	medium.runUntil((packetCount + 2) * PacketIntervalNanoseconds);
+
+	{
+		VirtualRadio::Scope scope(receiver);
+		takeCompletedBuffers(result.receivedIntact, result.receivedOther, expectedSequence);
+		result.overruns = ContinuousReceiver::overrunCount();
+		ContinuousReceiver::stop();
+	}
+
+	result.isPassed = result.receivedIntact == result.sent
+			&& result.receivedOther == 0
+			&& result.overruns == 0;
+	return result;
+}
+
+
+
+LogicalAddressResult DriverScenarios::continuousReceiveLogicalAddress() {
+	// Each packet (fast ramp up 40 uSec, then 60 uSec on-air at 2 Mbit) ends before the other's START
+	const uint64_t FirstSendTime = 100 * NanosecondsPerMicrosecond;
+	const uint64_t SecondSendTime = 170 * NanosecondsPerMicrosecond;
+	// ADDRESS is 20 uSec after START
+	const uint64_t FirstAddressTime = FirstSendTime + 60 * NanosecondsPerMicrosecond;
+	const uint64_t SecondAddressTime = SecondSendTime + 60 * NanosecondsPerMicrosecond;
+	const uint64_t ISRDelay = 5 * NanosecondsPerMicrosecond;
+
+	LogicalAddressResult result = LogicalAddressResult();
+	VirtualMedium medium;
+	VirtualRadio& first = medium.addNode(1);
+	VirtualRadio& second = medium.addNode(2);
+	VirtualRadio& receiver = medium.addNode(3);
+
+	uint8_t transmitBuffers[2][PayloadCount];
+	uint8_t receiveBuffers[ContinuousReceiver::MaxBufferCount][PayloadCount];
+
+	VirtualRadio* senders[2] = { &first, &second };
+	for (uint8_t logicalAddress = 0; logicalAddress < 2; logicalAddress++) {
+		VirtualRadio::Scope scope(*senders[logicalAddress]);
+		configureNode();
+		RadioDevice::configureTXLogicalAddress(logicalAddress);
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+		fillPacket(transmitBuffers[logicalAddress], logicalAddress);
+		RadioDevice::configurePacketAddress(transmitBuffers[logicalAddress]);
+	}
+	// No interrupt handler: the scenario runs the ISR itself
+	startContinuousReceiver(receiver, receiveBuffers, 0);
+	receiver.setInterruptHandler(nullptr);
+	{
+		VirtualRadio::Scope scope(receiver);
+		RadioDevice::configureRXLogicalAddresses(0x03);
+	}
+
+	medium.callAt(FirstSendTime, first, []() { RadioDevice::startTXTask(); });
+	medium.callAt(SecondSendTime, second, []() { RadioDevice::startTXTask(); });
+	// ADDRESS of the first packet; END of the first together with ADDRESS of the second; END of the second
+	medium.callAt(FirstAddressTime + ISRDelay, receiver, ContinuousReceiver::radioISR);
+	medium.callAt(SecondAddressTime + ISRDelay, receiver, ContinuousReceiver::radioISR);
+	medium.callAt(SecondAddressTime + 50 * NanosecondsPerMicrosecond, receiver, ContinuousReceiver::radioISR);
+	medium.runUntil(SecondSendTime + 200 * NanosecondsPerMicrosecond);
+
+	{
+		VirtualRadio::Scope scope(receiver);
+		while (ContinuousReceiver::isCompletedBuffer() && result.receivedIntact < 2) {
+			if (ContinuousReceiver::isCompletedBufferCRCValid()
+					&& isPacket(ContinuousReceiver::completedBuffer(), result.receivedIntact)) {
+				result.logicalAddresses[result.receivedIntact] = ContinuousReceiver::completedBufferLogicalAddress();
+				result.receivedIntact++;
+			}
+			ContinuousReceiver::releaseCompletedBuffer();
+		}
+		ContinuousReceiver::stop();
+	}
+
+	result.isPassed = result.receivedIntact == 2
+			&& result.logicalAddresses[0] == 0
+			&& result.logicalAddresses[1] == 1;
+	return result;
+}
+
+
+
+BurstTransmitResult DriverScenarios::burstTransmit(uint32_t packetCount, uint32_t interruptLatencyNanoseconds) {
+	// App period: shorter than a packet, so the queue never runs dry and buffers never pile up
+	const uint64_t AppIntervalNanoseconds = 50 * NanosecondsPerMicrosecond;
+
+	assert(packetCount <= MaxBurstPacketCount);
+
+	BurstTransmitResult result = BurstTransmitResult();
+	VirtualMedium medium;
+	VirtualRadio& sender = medium.addNode(1);
+	VirtualRadio& receiver = medium.addNode(2);
+
+	uint8_t transmitBuffers[MaxBurstPacketCount][PayloadCount];
+	uint8_t receiveBuffers[ContinuousReceiver::MaxBufferCount][PayloadCount];
+	uint32_t expectedSequence = 0;
+	// Engine is a singleton: its count runs on from earlier scenarios
+	unsigned int sentCountBefore;
+
+	{
+		VirtualRadio::Scope scope(sender);
+		sentCountBefore = BurstTransmitter::sentCount();
+		sender.setInterruptHandler(BurstTransmitter::radioISR);
+		sender.setInterruptLatencyNanoseconds(interruptLatencyNanoseconds);
+		configureNode();
+	}
+	startContinuousReceiver(receiver, receiveBuffers, interruptLatencyNanoseconds);
+
+	// Sender's app: keep the queue full, start when idle
+	std::function<void()> sendMore = [&]() {
+		while (result.enqueued < packetCount && !BurstTransmitter::isFull()) {
+			fillPacket(transmitBuffers[result.enqueued], result.enqueued);
+			BurstTransmitter::enqueue(transmitBuffers[result.enqueued]);
+			result.enqueued++;
+		}
+		if (!BurstTransmitter::isBusy() && BurstTransmitter::queuedCount() > 0) {
+			BurstTransmitter::start();
+		}
+	};
+	std::function<void()> receive = [&]() {
+		takeCompletedBuffers(result.receivedIntact, result.receivedOther, expectedSequence);
+	};
+
+	// Enough app turns for the whole burst, at a packet per 150 uSec at worst
+	const uint32_t turnCount = 3 * packetCount + 10;
+	for (uint32_t turn = 1; turn <= turnCount; turn++) {
+		medium.callAt(turn * AppIntervalNanoseconds, sender, sendMore);
+		medium.callAt(turn * AppIntervalNanoseconds + AppIntervalNanoseconds / 2, receiver, receive);
+	}
+	medium.runUntil((turnCount + 1) * AppIntervalNanoseconds);
+
+	{
+		VirtualRadio::Scope scope(sender);
+		result.sentCount = BurstTransmitter::sentCount() - sentCountBefore;
+		result.isIdle = !BurstTransmitter::isBusy() && BurstTransmitter::queuedCount() == 0;
+	}
+	{
+		VirtualRadio::Scope scope(receiver);
+		receive();
+		ContinuousReceiver::stop();
+	}
+	result.transmissions = (uint32_t) medium.statistics().transmissions;
+
+	result.isPassed = result.isIdle
+			&& result.sentCount == packetCount
+			&& result.transmissions == packetCount
+			&& result.receivedIntact == packetCount
+			&& result.receivedOther == 0;
+	return result;
+}
+
+
+
+EarlyRejectResult DriverScenarios::earlyReject() {
+	const uint64_t PacketIntervalNanoseconds = 1000 * NanosecondsPerMicrosecond;
+	const uint8_t ForeignS0 = 0x17;
+	const uint8_t MatchingS0 = 0x42;
+	const uint8_t PayloadLength = 50;
+	const uint8_t matchValue[] = { MatchingS0 };
+	const uint8_t matchMask[] = { 0xFF };
+
+	// What the receiver's app saw at each DISABLED, and when the sender ended each packet
+	struct Reception {
+		uint64_t disabledAt;
+		bool isEnd;
+		bool isRejected;
+		bool isCRCValid;
+		bool isPayloadSent;
+	};
+	Reception receptions[2] = {};
+	unsigned int receptionCount = 0;
+	uint64_t senderEndAt[2] = {};
+	unsigned int senderEndCount = 0;
+
+	EarlyRejectResult result = EarlyRejectResult();
+	VirtualMedium medium;
+	VirtualRadio& sender = medium.addNode(1);
+	VirtualRadio& receiver = medium.addNode(2);
+
+	// S0, LENGTH, payload
+	uint8_t transmitBuffer[2 + MaxDynamicPayloadCount];
+	uint8_t receiveBuffer[2 + MaxDynamicPayloadCount];
+
+	{
+		VirtualRadio::Scope scope(sender);
+		sender.setInterruptHandler([&]() {
+			if (RadioDevice::isEndEvent()) {
+				RadioDevice::clearEndEvent();
+				if (senderEndCount < 2) senderEndAt[senderEndCount++] = medium.now();
+			}
+		});
+		configureDynamicNode();
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+		RadioDevice::enableInterruptForEndEvent();
+	}
+	{
+		VirtualRadio::Scope scope(receiver);
+		receiver.setInterruptHandler([&]() {
+			EarlyRejectFilter::radioISR();
+			if (RadioDevice::isDisabledEventSet()) {
+				RadioDevice::clearDisabledEvent();
+				if (receptionCount < 2) {
+					Reception& reception = receptions[receptionCount++];
+					reception.disabledAt = medium.now();
+					reception.isEnd = RadioDevice::isEndEvent();
+					reception.isRejected = EarlyRejectFilter::isRejected();
+					reception.isCRCValid = RadioDevice::isCRCValid();
+					reception.isPayloadSent = receiveBuffer[1] == PayloadLength && isPacket(&receiveBuffer[2], 1);
+				}
+				RadioDevice::clearEndEvent();
+				// Listen again
+				EarlyRejectFilter::arm();
+				RadioDevice::startRXTask();
+			}
+		});
+		configureDynamicNode();
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+		EarlyRejectFilter::configure(DynamicFormat, matchValue, matchMask, 1);
+		EarlyRejectFilter::arm();
+		RadioDevice::enableInterruptForDisabledEvent();
+		RadioDevice::configurePacketAddress(receiveBuffer);
+		RadioDevice::startRXTask();
+	}
+
+	for (uint32_t sequence = 0; sequence < 2; sequence++) {
+		medium.callAt((sequence + 1) * PacketIntervalNanoseconds, sender, [&transmitBuffer, sequence, ForeignS0, MatchingS0, PayloadLength]() {
+			transmitBuffer[0] = sequence == 0 ? ForeignS0 : MatchingS0;
+			transmitBuffer[1] = PayloadLength;
+			// Payload recognizable, as fillPacket() (its first PayloadCount bytes)
+			fillPacket(&transmitBuffer[2], sequence);
+			RadioDevice::configurePacketAddress(transmitBuffer);
+			RadioDevice::startTXTask();
+		});
+	}
+	medium.runUntil(3 * PacketIntervalNanoseconds);
+
+	if (receptionCount == 2 && senderEndCount == 2) {
+		const Reception& foreign = receptions[0];
+		const Reception& matching = receptions[1];
+
+		result.isForeignRejected = foreign.isRejected && !foreign.isEnd;
+		result.isForeignDisabledEarly = foreign.disabledAt < senderEndAt[0];
+		if (result.isForeignDisabledEarly) {
+			result.foreignSavedMicroseconds = (uint32_t) ((senderEndAt[0] - foreign.disabledAt) / NanosecondsPerMicrosecond);
+		}
+		result.isMatchingReceivedWhole = !matching.isRejected && matching.isEnd
+				&& matching.isCRCValid && matching.isPayloadSent;
+	}
+	{
+		VirtualRadio::Scope scope(receiver);
+		EarlyRejectFilter::disarm();
+	}
+
+	result.isPassed = result.isForeignRejected
+			&& result.isForeignDisabledEarly
+			&& result.isMatchingReceivedWhole;
+	return result;
+}
+
+
+
+ChannelScanResult DriverScenarios::channelScan() {
+	const uint8_t BusyFrequency = 4;
+	const uint8_t frequencies[] = { 2, BusyFrequency, 6 };
+	const unsigned int ChannelCount = sizeof(frequencies);
+	const uint64_t SendTime = 100 * NanosecondsPerMicrosecond;
+	// After sender's ramp up: the packet (about 280 uSec) is on-air through the scan
+	const uint64_t ScanTime = SendTime + 50 * NanosecondsPerMicrosecond;
+
+	ChannelScanResult result = ChannelScanResult();
+	VirtualMedium medium;
+	VirtualRadio& sender = medium.addNode(1);
+	VirtualRadio& scanner = medium.addNode(2);
+
+	uint8_t transmitBuffer[2 + MaxDynamicPayloadCount] = {};
+
+	{
+		VirtualRadio::Scope scope(sender);
+		configureDynamicNode();
+		RadioDevice::configureFixedFrequency(BusyFrequency);
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+	}
+	{
+		VirtualRadio::Scope scope(scanner);
+		scanner.setInterruptHandler(ChannelScanner::radioISR);
+		configureDynamicNode();
+		ChannelScanner::configure(frequencies, ChannelCount, 4);
+	}
+
+	medium.callAt(SendTime, sender, [&transmitBuffer]() {
+		transmitBuffer[1] = MaxDynamicPayloadCount;
+		RadioDevice::configurePacketAddress(transmitBuffer);
+		RadioDevice::startTXTask();
+	});
+	medium.callAt(ScanTime, scanner, []() {
+		ChannelScanner::start();
+	});
+	medium.runUntil(ScanTime + 1000 * NanosecondsPerMicrosecond);
+
+	{
+		VirtualRadio::Scope scope(scanner);
+		if (!ChannelScanner::isDone()) {
+			return result;
+		}
+		const ChannelScanner::ChannelQuality* ranked = ChannelScanner::rankedResults();
+		result.quietestChannel = ranked[0].frequencyIndex;
+		result.strongestQuietSample = 127;
+		for (unsigned int i = 0; i < ChannelScanner::resultCount(); i++) {
+			if (ranked[i].frequencyIndex == BusyFrequency) {
+				result.busySample = ranked[i].strongestSample;
+			}
+			else if (ranked[i].strongestSample < result.strongestQuietSample) {
+				result.strongestQuietSample = ranked[i].strongestSample;
+			}
+		}
+		result.isPassed = ranked[ChannelCount - 1].frequencyIndex == BusyFrequency
+				&& result.busySample < result.strongestQuietSample;
+	}
+	return result;
+}
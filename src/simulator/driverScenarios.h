@@ -0,0 +1,123 @@
+#pragma once
+
+#include <inttypes.h>
+
+
+/*
+ * Result of a ContinuousReceiver scenario.
+ */
+struct ContinuousReceiveResult {
+	uint32_t sent;
+	// Handed to the app with CRC valid and the content sent, in order
+	uint32_t receivedIntact;
+	uint32_t receivedOther;
+	uint32_t overruns;
+	// Every packet sent received intact, none counted as overrun
+	bool isPassed;
+};
+
+
+/*
+ * Result of the ContinuousReceiver logical address scenario: two packets, on logical address 0 then 1.
+ */
+struct LogicalAddressResult {
+	uint32_t receivedIntact;
+	// As ContinuousReceiver::completedBufferLogicalAddress(), in order received
+	uint8_t logicalAddresses[2];
+	// Both packets received intact, each with the logical address it was sent on
+	bool isPassed;
+};
+
+
+/*
+ * Result of a BurstTransmitter scenario.
+ */
+struct BurstTransmitResult {
+	uint32_t enqueued;
+	// BurstTransmitter::sentCount() during the scenario
+	uint32_t sentCount;
+	// On-air, as the medium counted them: a stale buffer sent again shows here
+	uint32_t transmissions;
+	uint32_t receivedIntact;
+	uint32_t receivedOther;
+	// Not busy, queue empty, at the end
+	bool isIdle;
+	bool isPassed;
+};
+
+
+/*
+ * Result of the EarlyRejectFilter scenario: one foreign packet, then one matching.
+ */
+struct EarlyRejectResult {
+	// Foreign packet: rejected, DISABLED before the sender finished it, no END
+	bool isForeignRejected;
+	bool isForeignDisabledEarly;
+	// Microseconds the receiver was disabled before the sender's END
+	uint32_t foreignSavedMicroseconds;
+	// Matching packet: not rejected, END with CRC valid and the payload sent
+	bool isMatchingReceivedWhole;
+	bool isPassed;
+};
+
+
+/*
+ * Result of the ChannelScanner scenario: one busy channel among quiet ones.
+ */
+struct ChannelScanResult {
+	uint8_t quietestChannel;
+	// As ChannelQuality::strongestSample (-dBm)
+	uint8_t busySample;
+	uint8_t strongestQuietSample;
+	// Busy channel ranked loudest, its sample stronger than any quiet channel's
+	bool isPassed;
+};
+
+
+/*
+ * Scenarios exercising the radio engines (src/drivers/radio) on the simulator:
+ * two nodes (or three), one medium, each engine as its app would use it.
+ *
+ * Each scenario checks what the engine promises and returns what it observed.
+ * Deterministic (no loss on the link.)
+ *
+ * Engines are singletons: a scenario uses each on one node only (see readme.)
+ */
+class DriverScenarios {
+public:
+	/*
+	 * A node sends packetCount numbered packets, one at a time, spaced well apart.
+	 * The other node receives with ContinuousReceiver (four buffers), the app taking buffers as they complete.
+	 * interruptLatencyNanoseconds longer than the packet (from ADDRESS to END) makes ADDRESS and END of a packet
+	 * both pending when the receiver's ISR runs.
+	 */
+	static ContinuousReceiveResult continuousReceiveZeroDrop(uint32_t packetCount, uint32_t interruptLatencyNanoseconds);
+
+	/*
+	 * Two nodes send a packet each, back to back, on logical address 0 resp. 1.
+	 * The other node receives both with ContinuousReceiver, its ISR run at chosen times:
+	 * on time for ADDRESS of the first packet, but late for its END, after ADDRESS of the second.
+	 */
+	static LogicalAddressResult continuousReceiveLogicalAddress();
+
+	/*
+	 * A node sends packetCount numbered packets with BurstTransmitter, its app keeping the queue full.
+	 * The other node receives with ContinuousReceiver.
+	 * interruptLatencyNanoseconds (both nodes) longer than the packet makes ADDRESS and END both pending
+	 * in the sender's ISR; it must stay below END to START of the next packet (TX disable plus ramp up.)
+	 */
+	static BurstTransmitResult burstTransmit(uint32_t packetCount, uint32_t interruptLatencyNanoseconds);
+
+	/*
+	 * A node sends a foreign packet (first byte S0 0x17), then a matching one (S0 0x42), dynamic format.
+	 * The other node receives with SinglePacket shortcuts and EarlyRejectFilter accepting S0 0x42,
+	 * listening again at each DISABLED.
+	 */
+	static EarlyRejectResult earlyReject();
+
+	/*
+	 * A node sends a long packet on FREQUENCY 4.
+	 * Meanwhile the other node scans FREQUENCY 2, 4, 6 with ChannelScanner.
+	 */
+	static ChannelScanResult channelScan();
+};
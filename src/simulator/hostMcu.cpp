@@ -0,0 +1,24 @@
+#include <cstdlib>	// abort
+
+#include "drivers/mcu.h"
+
+/*
+ * MCU for a host build of the drivers: the simulated peripherals see writes at once.
+ * Sleeping returns at once: simulated time only passes between node code.
+ */
+
+void MCU::sleepUntilEvent() {}
+void MCU::sleepUntilInterrupt() {}
+void MCU::clearEventRegister() {}
+void MCU::flushWriteCache() {}
+void MCU::enableInstructionCache() {}
+void MCU::disableIRQ() {}
+
+bool MCU::isResetReason() { return false; }
+void MCU::clearResetReason() {}
+
+bool MCU::isDebugMode() { return false; }
+// No cycle counter, as on nrf51
+void MCU::enableCycleCounter() {}
+uint32_t MCU::cycleCount() { return 0; }
+void MCU::breakIntoDebuggerOrHardfault() { abort(); }
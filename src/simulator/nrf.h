@@ -0,0 +1,279 @@
+#pragma once
+
+#include <inttypes.h>
+
+/*
+ * Host stand-in for Nordic's nrf.h, used only when building src/drivers/radio for the simulator.
+ *
+ * Put src/simulator first on the include path: the drivers' #include "nrf.h" then resolves here.
+ *
+ * Models only the RADIO and FICR peripherals, as an nRF52832 (NRF52_SERIES.)
+ * NRF_RADIO (resp. NRF_FICR) designates the register block of the current simulated node, see VirtualRadio::Scope.
+ *
+ * Most registers are plain memory: the virtual radio reads them when it needs them (e.g. FREQUENCY at START.)
+ * Registers with side effects on write are small classes:
+ * - TASKS_x: writing nonzero triggers the task on the node's virtual radio
+ * - INTENSET, INTENCLR: write-one-to-set, write-one-to-clear, both read the enable mask
+ * - POWER: writing 0 resets the radio's registers
+ * - PACKETPTR: holds a full host pointer (drivers write it through uintptr_t)
+ *
+ * Register field masks are those of nRF52832.
+ */
+
+#ifndef NRF52_SERIES
+#define NRF52_SERIES
+#endif
+#ifndef NRF52832_XXAA
+#define NRF52832_XXAA
+#endif
+
+
+class VirtualRadio;
+
+enum class VirtualRadioTask { TXEN, RXEN, START, STOP, DISABLE, RSSISTART, RSSISTOP, BCSTART, BCSTOP };
+
+
+class VirtualTaskRegister {
+	VirtualRadio* owner = nullptr;
+	VirtualRadioTask task = VirtualRadioTask::TXEN;
+public:
+	void bind(VirtualRadio* anOwner, VirtualRadioTask aTask) { owner = anOwner; task = aTask; }
+	VirtualTaskRegister& operator=(uint32_t value);
+	// Task registers are write only, read as zero
+	operator uint32_t() const { return 0; }
+};
+
+class VirtualInterruptEnableRegister {
+	uint32_t mask = 0;
+public:
+	VirtualInterruptEnableRegister& operator=(uint32_t value) { mask |= value; return *this; }
+	operator uint32_t() const { return mask; }
+	void clear(uint32_t value) { mask &= ~value; }
+};
+
+class VirtualInterruptDisableRegister {
+	VirtualInterruptEnableRegister* enable = nullptr;
+public:
+	void bind(VirtualInterruptEnableRegister* anEnable) { enable = anEnable; }
+	VirtualInterruptDisableRegister& operator=(uint32_t value) { enable->clear(value); return *this; }
+	operator uint32_t() const { return *enable; }
+};
+
+class VirtualPowerRegister {
+	VirtualRadio* owner = nullptr;
+	uint32_t value = 1;
+public:
+	void bind(VirtualRadio* anOwner) { owner = anOwner; }
+	VirtualPowerRegister& operator=(uint32_t aValue);
+	operator uint32_t() const { return value; }
+};
+
+class VirtualPointerRegister {
+	uintptr_t value = 0;
+public:
+	VirtualPointerRegister& operator=(uintptr_t aValue) { value = aValue; return *this; }
+	operator uintptr_t() const { return value; }
+};
+
+
+
+typedef struct {
+	VirtualTaskRegister TASKS_TXEN;
+	VirtualTaskRegister TASKS_RXEN;
+	VirtualTaskRegister TASKS_START;
+	VirtualTaskRegister TASKS_STOP;
+	VirtualTaskRegister TASKS_DISABLE;
+	VirtualTaskRegister TASKS_RSSISTART;
+	VirtualTaskRegister TASKS_RSSISTOP;
+	VirtualTaskRegister TASKS_BCSTART;
+	VirtualTaskRegister TASKS_BCSTOP;
+
+	volatile uint32_t EVENTS_READY;
+	volatile uint32_t EVENTS_ADDRESS;
+	volatile uint32_t EVENTS_PAYLOAD;
+	volatile uint32_t EVENTS_END;
+	volatile uint32_t EVENTS_DISABLED;
+	volatile uint32_t EVENTS_DEVMATCH;
+	volatile uint32_t EVENTS_DEVMISS;
+	volatile uint32_t EVENTS_RSSIEND;
+	volatile uint32_t EVENTS_BCMATCH;
+	volatile uint32_t EVENTS_CRCOK;
+	volatile uint32_t EVENTS_CRCERROR;
+
+	volatile uint32_t SHORTS;
+	VirtualInterruptEnableRegister INTENSET;
+	VirtualInterruptDisableRegister INTENCLR;
+	volatile uint32_t CRCSTATUS;
+	volatile uint32_t RXMATCH;
+	volatile uint32_t RXCRC;
+	volatile uint32_t DAI;
+	VirtualPointerRegister PACKETPTR;
+	volatile uint32_t FREQUENCY;
+	volatile uint32_t TXPOWER;
+	volatile uint32_t MODE;
+	volatile uint32_t PCNF0;
+	volatile uint32_t PCNF1;
+	volatile uint32_t BASE0;
+	volatile uint32_t BASE1;
+	volatile uint32_t PREFIX0;
+	volatile uint32_t PREFIX1;
+	volatile uint32_t TXADDRESS;
+	volatile uint32_t RXADDRESSES;
+	volatile uint32_t CRCCNF;
+	volatile uint32_t CRCPOLY;
+	volatile uint32_t CRCINIT;
+	volatile uint32_t TIFS;
+	volatile uint32_t RSSISAMPLE;
+	volatile uint32_t STATE;
+	volatile uint32_t DATAWHITEIV;
+	volatile uint32_t BCC;
+	volatile uint32_t DAB[8];
+	volatile uint32_t DAP[8];
+	volatile uint32_t DACNF;
+	volatile uint32_t MODECNF0;
+	VirtualPowerRegister POWER;
+} NRF_RADIO_Type;
+
+typedef struct {
+	volatile uint32_t DEVICEID[2];
+	volatile uint32_t DEVICEADDR[2];
+} NRF_FICR_Type;
+
+
+/*
+ * Defined in virtualRadio.cpp.
+ * Asserts that some node is current.
+ */
+NRF_RADIO_Type* virtualRadioRegisters();
+NRF_FICR_Type* virtualFICRRegisters();
+
+#define NRF_RADIO (virtualRadioRegisters())
+#define NRF_FICR (virtualFICRRegisters())
+
+
+
+#define RADIO_SHORTS_READY_START_Pos (0UL)
+#define RADIO_SHORTS_READY_START_Msk (0x1UL << RADIO_SHORTS_READY_START_Pos)
+#define RADIO_SHORTS_READY_START_Enabled (1UL)
+#define RADIO_SHORTS_END_DISABLE_Pos (1UL)
+#define RADIO_SHORTS_END_DISABLE_Msk (0x1UL << RADIO_SHORTS_END_DISABLE_Pos)
+#define RADIO_SHORTS_END_DISABLE_Enabled (1UL)
+#define RADIO_SHORTS_DISABLED_TXEN_Pos (2UL)
+#define RADIO_SHORTS_DISABLED_TXEN_Msk (0x1UL << RADIO_SHORTS_DISABLED_TXEN_Pos)
+#define RADIO_SHORTS_DISABLED_RXEN_Pos (3UL)
+#define RADIO_SHORTS_DISABLED_RXEN_Msk (0x1UL << RADIO_SHORTS_DISABLED_RXEN_Pos)
+#define RADIO_SHORTS_ADDRESS_RSSISTART_Pos (4UL)
+#define RADIO_SHORTS_ADDRESS_RSSISTART_Msk (0x1UL << RADIO_SHORTS_ADDRESS_RSSISTART_Pos)
+#define RADIO_SHORTS_END_START_Pos (5UL)
+#define RADIO_SHORTS_END_START_Msk (0x1UL << RADIO_SHORTS_END_START_Pos)
+#define RADIO_SHORTS_ADDRESS_BCSTART_Pos (6UL)
+#define RADIO_SHORTS_ADDRESS_BCSTART_Msk (0x1UL << RADIO_SHORTS_ADDRESS_BCSTART_Pos)
+#define RADIO_SHORTS_DISABLED_RSSISTOP_Pos (8UL)
+#define RADIO_SHORTS_DISABLED_RSSISTOP_Msk (0x1UL << RADIO_SHORTS_DISABLED_RSSISTOP_Pos)
+
+#define RADIO_INTENSET_READY_Msk (0x1UL << 0)
+#define RADIO_INTENSET_ADDRESS_Msk (0x1UL << 1)
+#define RADIO_INTENSET_PAYLOAD_Msk (0x1UL << 2)
+#define RADIO_INTENSET_END_Msk (0x1UL << 3)
+#define RADIO_INTENSET_DISABLED_Msk (0x1UL << 4)
+#define RADIO_INTENSET_DEVMATCH_Msk (0x1UL << 5)
+#define RADIO_INTENSET_DEVMISS_Msk (0x1UL << 6)
+#define RADIO_INTENSET_RSSIEND_Msk (0x1UL << 7)
+#define RADIO_INTENSET_BCMATCH_Msk (0x1UL << 10)
+#define RADIO_INTENSET_CRCOK_Msk (0x1UL << 12)
+#define RADIO_INTENSET_CRCERROR_Msk (0x1UL << 13)
+#define RADIO_INTENCLR_READY_Msk RADIO_INTENSET_READY_Msk
+#define RADIO_INTENCLR_ADDRESS_Msk RADIO_INTENSET_ADDRESS_Msk
+#define RADIO_INTENCLR_PAYLOAD_Msk RADIO_INTENSET_PAYLOAD_Msk
+#define RADIO_INTENCLR_END_Msk RADIO_INTENSET_END_Msk
+#define RADIO_INTENCLR_DISABLED_Msk RADIO_INTENSET_DISABLED_Msk
+#define RADIO_INTENCLR_DEVMATCH_Msk RADIO_INTENSET_DEVMATCH_Msk
+#define RADIO_INTENCLR_DEVMISS_Msk RADIO_INTENSET_DEVMISS_Msk
+#define RADIO_INTENCLR_RSSIEND_Msk RADIO_INTENSET_RSSIEND_Msk
+#define RADIO_INTENCLR_BCMATCH_Msk RADIO_INTENSET_BCMATCH_Msk
+#define RADIO_INTENCLR_CRCOK_Msk RADIO_INTENSET_CRCOK_Msk
+#define RADIO_INTENCLR_CRCERROR_Msk RADIO_INTENSET_CRCERROR_Msk
+
+#define RADIO_STATE_STATE_Disabled (0UL)
+#define RADIO_STATE_STATE_RxRu (1UL)
+#define RADIO_STATE_STATE_RxIdle (2UL)
+#define RADIO_STATE_STATE_Rx (3UL)
+#define RADIO_STATE_STATE_RxDisable (4UL)
+#define RADIO_STATE_STATE_TxRu (9UL)
+#define RADIO_STATE_STATE_TxIdle (10UL)
+#define RADIO_STATE_STATE_Tx (11UL)
+#define RADIO_STATE_STATE_TxDisable (12UL)
+
+#define RADIO_FREQUENCY_FREQUENCY_Msk (0x7FUL << 0)
+#define RADIO_FREQUENCY_MAP_Msk (0x1UL << 8)
+
+#define RADIO_TXPOWER_TXPOWER_Pos4dBm (0x04UL)
+#define RADIO_TXPOWER_TXPOWER_Pos3dBm (0x03UL)
+#define RADIO_TXPOWER_TXPOWER_0dBm (0x00UL)
+#define RADIO_TXPOWER_TXPOWER_Neg4dBm (0xFCUL)
+#define RADIO_TXPOWER_TXPOWER_Neg8dBm (0xF8UL)
+#define RADIO_TXPOWER_TXPOWER_Neg12dBm (0xF4UL)
+#define RADIO_TXPOWER_TXPOWER_Neg16dBm (0xF0UL)
+#define RADIO_TXPOWER_TXPOWER_Neg20dBm (0xECUL)
+#define RADIO_TXPOWER_TXPOWER_Neg30dBm (0xE2UL)
+#define RADIO_TXPOWER_TXPOWER_Neg40dBm (0xD8UL)
+
+#define RADIO_MODE_MODE_Nrf_1Mbit (0UL)
+#define RADIO_MODE_MODE_Nrf_2Mbit (1UL)
+#define RADIO_MODE_MODE_Nrf_250Kbit (2UL)
+#define RADIO_MODE_MODE_Ble_1Mbit (3UL)
+#define RADIO_MODE_MODE_Ble_2Mbit (4UL)
+
+#define RADIO_PCNF0_LFLEN_Pos (0UL)
+#define RADIO_PCNF0_LFLEN_Msk (0xFUL << RADIO_PCNF0_LFLEN_Pos)
+#define RADIO_PCNF0_S0LEN_Pos (8UL)
+#define RADIO_PCNF0_S0LEN_Msk (0x1UL << RADIO_PCNF0_S0LEN_Pos)
+#define RADIO_PCNF0_S1LEN_Pos (16UL)
+#define RADIO_PCNF0_S1LEN_Msk (0xFUL << RADIO_PCNF0_S1LEN_Pos)
+#define RADIO_PCNF0_S1INCL_Pos (20UL)
+#define RADIO_PCNF0_S1INCL_Msk (0x1UL << RADIO_PCNF0_S1INCL_Pos)
+#define RADIO_PCNF0_PLEN_Pos (24UL)
+#define RADIO_PCNF0_PLEN_Msk (0x1UL << RADIO_PCNF0_PLEN_Pos)
+#define RADIO_PCNF0_PLEN_8bit (0UL)
+#define RADIO_PCNF0_PLEN_16bit (1UL)
+
+#define RADIO_PCNF1_MAXLEN_Pos (0UL)
+#define RADIO_PCNF1_MAXLEN_Msk (0xFFUL << RADIO_PCNF1_MAXLEN_Pos)
+#define RADIO_PCNF1_STATLEN_Pos (8UL)
+#define RADIO_PCNF1_STATLEN_Msk (0xFFUL << RADIO_PCNF1_STATLEN_Pos)
+#define RADIO_PCNF1_BALEN_Pos (16UL)
+#define RADIO_PCNF1_BALEN_Msk (0x7UL << RADIO_PCNF1_BALEN_Pos)
+#define RADIO_PCNF1_ENDIAN_Pos (24UL)
+#define RADIO_PCNF1_ENDIAN_Msk (0x1UL << RADIO_PCNF1_ENDIAN_Pos)
+#define RADIO_PCNF1_ENDIAN_Little (0UL)
+#define RADIO_PCNF1_ENDIAN_Big (1UL)
+#define RADIO_PCNF1_WHITEEN_Pos (25UL)
+#define RADIO_PCNF1_WHITEEN_Msk (0x1UL << RADIO_PCNF1_WHITEEN_Pos)
+#define RADIO_PCNF1_WHITEEN_Enabled (1UL)
+
+#define RADIO_PREFIX0_AP0_Pos (0UL)
+#define RADIO_PREFIX0_AP0_Msk (0xFFUL << RADIO_PREFIX0_AP0_Pos)
+
+#define RADIO_CRCCNF_LEN_Pos (0UL)
+#define RADIO_CRCCNF_LEN_Msk (0x3UL << RADIO_CRCCNF_LEN_Pos)
+#define RADIO_CRCCNF_LEN_Disabled (0UL)
+#define RADIO_CRCCNF_LEN_One (1UL)
+#define RADIO_CRCCNF_LEN_Two (2UL)
+#define RADIO_CRCCNF_LEN_Three (3UL)
+#define RADIO_CRCCNF_SKIPADDR_Pos (8UL)
+#define RADIO_CRCCNF_SKIPADDR_Msk (0x1UL << RADIO_CRCCNF_SKIPADDR_Pos)
+#define RADIO_CRCCNF_SKIPADDR_Include (0UL)
+#define RADIO_CRCCNF_SKIPADDR_Skip (1UL)
+
+#define RADIO_RSSISAMPLE_RSSISAMPLE_Msk (0x7FUL)
+#define RADIO_DATAWHITEIV_DATAWHITEIV_Msk (0x7FUL)
+
+#define RADIO_MODECNF0_RU_Pos (0UL)
+#define RADIO_MODECNF0_RU_Msk (0x1UL << RADIO_MODECNF0_RU_Pos)
+#define RADIO_MODECNF0_RU_Default (0UL)
+#define RADIO_MODECNF0_RU_Fast (1UL)
+#define RADIO_MODECNF0_DTX_Pos (8UL)
+#define RADIO_MODECNF0_DTX_Msk (0x3UL << RADIO_MODECNF0_DTX_Pos)
+#define RADIO_MODECNF0_DTX_B1 (0UL)
+#define RADIO_MODECNF0_DTX_B0 (1UL)
+#define RADIO_MODECNF0_DTX_Center (2UL)
@@ -0,0 +1,77 @@
+#include <cstdio>
+
+#include "driverScenarios.h"
+
+
+/*
+ * Runs the driver scenarios and reports each.
+ * Exit status is nonzero if any failed.
+ */
+
+namespace {
+
+const uint32_t NoLatency = 0;
+// Longer than a scenario packet from ADDRESS to END (40 uSec at 2 Mbit)
+const uint32_t LateLatency = 60000;
+
+bool report(const char* name, bool isPassed) {
+	printf("%-44s %s\n", name, isPassed ? "pass" : "FAIL");
+	return isPassed;
+}
+
+bool reportContinuousReceive(const char* name, const ContinuousReceiveResult& result) {
+	printf("  sent %u intact %u other %u overruns %u\n",
+			result.sent, result.receivedIntact, result.receivedOther, result.overruns);
+	return report(name, result.isPassed);
+}
+
+bool reportLogicalAddress(const char* name, const LogicalAddressResult& result) {
+	printf("  intact %u logical addresses %u %u\n",
+			result.receivedIntact, result.logicalAddresses[0], result.logicalAddresses[1]);
+	return report(name, result.isPassed);
+}
+
+bool reportBurstTransmit(const char* name, const BurstTransmitResult& result) {
+	printf("  enqueued %u sentCount %u on-air %u intact %u other %u idle %d\n",
+			result.enqueued, result.sentCount, result.transmissions,
+			result.receivedIntact, result.receivedOther, result.isIdle);
+	return report(name, result.isPassed);
+}
+
+bool reportEarlyReject(const char* name, const EarlyRejectResult& result) {
+	printf("  foreign rejected %d early %d (%u uSec saved) matching whole %d\n",
+			result.isForeignRejected, result.isForeignDisabledEarly, result.foreignSavedMicroseconds,
+			result.isMatchingReceivedWhole);
+	return report(name, result.isPassed);
+}
+
+bool reportChannelScan(const char* name, const ChannelScanResult& result) {
+	printf("  quietest %u busy -%u dBm quiet -%u dBm\n",
+			result.quietestChannel, result.busySample, result.strongestQuietSample);
+	return report(name, result.isPassed);
+}
+
+}  // namespace
+
+
+
+int main() {
+	bool isAllPassed = true;
+
+	isAllPassed &= reportContinuousReceive("ContinuousReceiver zero drop",
+			DriverScenarios::continuousReceiveZeroDrop(100, NoLatency));
+	isAllPassed &= reportContinuousReceive("ContinuousReceiver zero drop, ISR late",
+			DriverScenarios::continuousReceiveZeroDrop(100, LateLatency));
+	isAllPassed &= reportLogicalAddress("ContinuousReceiver logical address, END late",
+			DriverScenarios::continuousReceiveLogicalAddress());
+
+	isAllPassed &= reportBurstTransmit("BurstTransmitter",
+			DriverScenarios::burstTransmit(40, NoLatency));
+	isAllPassed &= reportBurstTransmit("BurstTransmitter, ISR late",
+			DriverScenarios::burstTransmit(40, LateLatency));
+
+	isAllPassed &= reportEarlyReject("EarlyRejectFilter", DriverScenarios::earlyReject());
+	isAllPassed &= reportChannelScan("ChannelScanner", DriverScenarios::channelScan());
+
+	return isAllPassed ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <cassert>
+#include <chrono>
+#include <cmath>	// log
+#include <vector>
+
+#include "simulationHarness.h"
+
+#include "radio/radio.h"
+
+
+namespace {
+
+const uint64_t NanosecondsPerMicrosecond = 1000;
+const uint8_t AddressLength = 4;
+const uint8_t MaxPayloadCount = 32;
+
+
+struct NodeApp {
+	uint8_t receiveBuffer[MaxPayloadCount];
+	uint8_t transmitBuffer[MaxPayloadCount];
+	bool isTransmitting;
+	uint64_t sent;
+	uint64_t receivedCRCValid;
+	uint64_t receivedCRCInvalid;
+};
+
+
+class Simulation {
+public:
+	Simulation(const SimulationParameters& aParameters) :
+		parameters(aParameters),
+		medium(aParameters.seed),
+		apps(aParameters.nodeCount)
+	{
+		assert(parameters.payloadCount <= MaxPayloadCount);
+		const VirtualLink link = parameters.link;
+		medium.setLinkModel([link](unsigned int, unsigned int) { return link; });
+	}
+
+	void run() {
+		for (unsigned int i = 0; i < parameters.nodeCount; i++) {
+			VirtualRadio& node = medium.addNode(0x5EED000000000000ull + i);
+			node.setInterruptHandler([this, i]() { onRadioInterrupt(i); });
+			VirtualRadio::Scope scope(node);
+			configureNode(i);
+			startListening(i);
+			scheduleTransmit(i);
+		}
+		medium.runUntil(parameters.durationMicroseconds * NanosecondsPerMicrosecond);
+	}
+
+	void collect(SimulationResult& result) const {
+		result.medium = medium.statistics();
+		result.packetsSent = 0;
+		result.packetsReceivedCRCValid = 0;
+		result.packetsReceivedCRCInvalid = 0;
+		for (const NodeApp& app : apps) {
+			result.packetsSent += app.sent;
+			result.packetsReceivedCRCValid += app.receivedCRCValid;
+			result.packetsReceivedCRCInvalid += app.receivedCRCInvalid;
+		}
+	}
+
+private:
+	const SimulationParameters parameters;
+	VirtualMedium medium;
+	std::vector<NodeApp> apps;
+
+
+	// Node code: runs with the node current, uses only the driver
+
+	void configureNode(unsigned int index) {
+		RadioDevice::powerOn();
+		RadioDevice::configureFixedFrequency(2 + 2 * (index % parameters.channelCount));
+		RadioDevice::configureFixedLogicalAddress();
+		RadioDevice::configureNetworkAddressPool();
+		RadioDevice::configureMediumCRC();
+		RadioDevice::configureStaticPacketFormat(parameters.payloadCount, AddressLength);
+		RadioDevice::configureWhiteningOn();
+		RadioDevice::configureMegaBitrate(2);
+		RadioDevice::configureFastRampUp();
+		RadioDevice::setShortcuts(RadioShortcutProfile::SinglePacket);
+		RadioDevice::enableInterruptForDisabledEvent();
+
+		NodeApp& app = apps[index];
+		for (unsigned int i = 0; i < parameters.payloadCount; i++) {
+			app.transmitBuffer[i] = (uint8_t) (index + i);
+		}
+		app.isTransmitting = false;
+		app.sent = 0;
+		app.receivedCRCValid = 0;
+		app.receivedCRCInvalid = 0;
+	}
+
+	void startListening(unsigned int index) {
+		apps[index].isTransmitting = false;
+		RadioDevice::configurePacketAddress(apps[index].receiveBuffer);
+		RadioDevice::startRXTask();
+	}
+
+	void startTransmitting(unsigned int index) {
+		apps[index].isTransmitting = true;
+		RadioDevice::configurePacketAddress(apps[index].transmitBuffer);
+		RadioDevice::startTXTask();
+	}
+
+	void onRadioInterrupt(unsigned int index) {
+		if (!RadioDevice::isDisabledEventSet()) {
+			return;
+		}
+		RadioDevice::clearDisabledEvent();
+
+		NodeApp& app = apps[index];
+		if (app.isTransmitting) {
+			app.sent++;
+		}
+		else if (RadioDevice::isCRCValid()) {
+			app.receivedCRCValid++;
+		}
+		else {
+			app.receivedCRCInvalid++;
+		}
+		startListening(index);
+	}
+
+	void onTransmitTimer(unsigned int index) {
+		if (!apps[index].isTransmitting) {
+			// Abandon listening: from RX, DISABLED at once.  Not a reception.
+			RadioDevice::startDisablingTask();
+			assert(RadioDevice::isDisabledState());
+			RadioDevice::clearDisabledEvent();
+			startTransmitting(index);
+		}
+		scheduleTransmit(index);
+	}
+
+
+	// Harness code
+
+	void scheduleTransmit(unsigned int index) {
+		double interval = -log(1.0 - medium.random()) * parameters.meanTransmitIntervalMicroseconds;
+		medium.callAt(medium.now() + (uint64_t) (interval * NanosecondsPerMicrosecond) + 1,
+				medium.node(index),
+				[this, index]() { onTransmitTimer(index); });
+	}
+};
+
+}  // namespace
+
+
+
+SimulationParameters SimulationHarness::defaultParameters() {
+	SimulationParameters parameters;
+	parameters.nodeCount = 1000;
+	parameters.channelCount = 8;
+	parameters.meanTransmitIntervalMicroseconds = 100000;
+	parameters.payloadCount = 16;
+	parameters.durationMicroseconds = 1000000;
+	parameters.link = VirtualLink{0, 0.0f, -60};
+	parameters.seed = 1;
+	return parameters;
+}
+
+
+SimulationResult SimulationHarness::run(const SimulationParameters& parameters) {
+	SimulationResult result;
+
+	auto wallStart = std::chrono::steady_clock::now();
+	Simulation simulation(parameters);
+	simulation.run();
+	auto wallEnd = std::chrono::steady_clock::now();
+
+	simulation.collect(result);
+	result.simulatedSeconds = parameters.durationMicroseconds / 1e6;
+	result.wallSeconds = std::chrono::duration<double>(wallEnd - wallStart).count();
+	result.nodeSecondsPerWallSecond = result.wallSeconds > 0
+			? parameters.nodeCount * result.simulatedSeconds / result.wallSeconds
+			: 0;
+	result.eventsPerWallSecond = result.wallSeconds > 0 ? result.medium.events / result.wallSeconds : 0;
+	return result;
+}
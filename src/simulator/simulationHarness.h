@@ -0,0 +1,51 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "virtualMedium.h"
+
+
+struct SimulationParameters {
+	unsigned int nodeCount;
+	// Nodes are spread round robin over this many frequencies (2, 4, 6, ...)
+	unsigned int channelCount;
+	// Each node transmits after exponentially distributed intervals with this mean
+	uint32_t meanTransmitIntervalMicroseconds;
+	uint8_t payloadCount;
+	uint64_t durationMicroseconds;
+	VirtualLink link;
+	uint32_t seed;
+};
+
+
+struct SimulationResult {
+	VirtualMediumStatistics medium;
+	// Counted by the nodes' apps, from what the driver reports
+	uint64_t packetsSent;
+	uint64_t packetsReceivedCRCValid;
+	uint64_t packetsReceivedCRCInvalid;
+
+	double simulatedSeconds;
+	double wallSeconds;
+	// Simulated node seconds per wall clock second: the harness's figure of merit
+	double nodeSecondsPerWallSecond;
+	double eventsPerWallSecond;
+};
+
+
+/*
+ * Benchmark harness: many nodes running the same small app on one medium.
+ *
+ * Each node's app uses RadioDevice (the real driver) against its virtual radio:
+ * - listens (RX, shortcut END->DISABLE, interrupt on DISABLED)
+ * - at random times, stops listening and transmits a static format packet, then listens again
+ * The interrupt handler counts what the driver reports (CRC valid or not.)
+ *
+ * Measures simulation throughput, and gives a quick view of a protocol's collision rate
+ * for a node count and duty cycle before trying it on hardware.
+ */
+class SimulationHarness {
+public:
+	static SimulationParameters defaultParameters();
+	static SimulationResult run(const SimulationParameters& parameters);
+};
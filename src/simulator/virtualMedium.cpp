@@ -0,0 +1,248 @@
+#include <cassert>
+
+#include "virtualMedium.h"
+
+
+namespace {
+
+/*
+ * Transmissions are kept this long after their END,
+ * longer than any propagation delay a link model should give.
+ */
+const uint64_t TransmissionRetentionNanoseconds = 1000000;
+
+VirtualLink defaultLink(unsigned int, unsigned int) {
+	return VirtualLink{0, 0.0f, -60};
+}
+
+}  // namespace
+
+
+
+VirtualMedium::VirtualMedium(uint32_t seed) :
+	nodes(),
+	pending(),
+	sequence(0),
+	_now(0),
+	transmissions(),
+	firstTransmissionID(1),
+	nextTransmissionID(1),
+	linkModel(defaultLink),
+	captureThresholdDB(DefaultCaptureThresholdDB),
+	noiseFloorDBm(DefaultNoiseFloorDBm),
+	sensitivityDBm(DefaultSensitivityDBm),
+	randomState(seed != 0 ? seed : 1),
+	_statistics()
+{}
+
+
+VirtualRadio& VirtualMedium::addNode(uint64_t deviceID) {
+	nodes.emplace_back(new VirtualRadio(*this, nodes.size(), deviceID));
+	return *nodes.back();
+}
+
+void VirtualMedium::setLinkModel(LinkModel model) { linkModel = model; }
+
+
+/*
+ * xorshift32
+ */
+float VirtualMedium::random() {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+
+
+void VirtualMedium::schedule(uint64_t time, Action action, VirtualRadio& node, uint32_t generation, uint64_t transmissionID) {
+	assert(time >= _now);
+	pending.push(ScheduledAction{time, sequence++, action, &node, generation, transmissionID, nullptr});
+}
+
+void VirtualMedium::callAt(uint64_t time, VirtualRadio& node, std::function<void()> call) {
+	assert(time >= _now);
+	pending.push(ScheduledAction{time, sequence++, Action::Call, &node, 0, 0, call});
+}
+
+
+bool VirtualMedium::runOne() {
+	if (pending.empty()) {
+		return false;
+	}
+	// Copy: dispatch may schedule more
+	ScheduledAction scheduled = pending.top();
+	pending.pop();
+	_now = scheduled.time;
+	_statistics.events++;
+	dispatch(scheduled);
+	return true;
+}
+
+void VirtualMedium::runUntil(uint64_t time) {
+	while (!pending.empty() && pending.top().time <= time) {
+		runOne();
+	}
+	_now = time;
+	pruneTransmissions();
+}
+
+
+void VirtualMedium::dispatch(const ScheduledAction& scheduled) {
+	VirtualRadio& node = *scheduled.node;
+
+	switch (scheduled.action) {
+	case Action::RampUpDone:
+		node.onRampUpDone(scheduled.generation);
+		break;
+	case Action::TXDisableDone:
+		node.onTXDisableDone(scheduled.generation);
+		break;
+	case Action::TransmitAddressDone:
+		node.onTransmitAddressDone(scheduled.generation, scheduled.transmissionID);
+		break;
+	case Action::TransmitEnd:
+		node.onTransmitEnd(scheduled.generation, scheduled.transmissionID);
+		break;
+	case Action::ReceiveAddress:
+	{
+		const VirtualTransmission* aTransmission = transmission(scheduled.transmissionID);
+		if (aTransmission != nullptr && !aTransmission->isAborted) {
+			node.onReceiveAddress(*aTransmission, receivedPowerDBm(*aTransmission, node.index()));
+		}
+	}
+		break;
+	case Action::ReceiveEnd:
+		node.onReceiveEnd(scheduled.generation, scheduled.transmissionID);
+		break;
+	case Action::BitCounterMatch:
+		node.onBitCounterMatch(scheduled.generation, scheduled.transmissionID);
+		break;
+	case Action::InterruptPending:
+		node.onInterruptPending();
+		break;
+	case Action::Call:
+	{
+		VirtualRadio::Scope scope(node);
+		scheduled.call();
+	}
+		break;
+	}
+}
+
+
+
+uint64_t VirtualMedium::beginTransmission(VirtualTransmission& aTransmission) {
+	aTransmission.id = nextTransmissionID++;
+	transmissions.push_back(aTransmission);
+	_statistics.transmissions++;
+	pruneTransmissions();
+	return aTransmission.id;
+}
+
+void VirtualMedium::abortTransmission(uint64_t transmissionID) {
+	VirtualTransmission* aTransmission = const_cast<VirtualTransmission*>(transmission(transmissionID));
+	if (aTransmission != nullptr && !aTransmission->isAborted) {
+		aTransmission->isAborted = true;
+		aTransmission->endTime = _now;
+		_statistics.aborted++;
+	}
+}
+
+const VirtualTransmission* VirtualMedium::transmission(uint64_t transmissionID) const {
+	if (transmissionID < firstTransmissionID || transmissionID >= nextTransmissionID) {
+		return nullptr;
+	}
+	return &transmissions[transmissionID - firstTransmissionID];
+}
+
+/*
+ * Only from the front, so ids stay contiguous: a long transmission delays pruning of shorter later ones.
+ */
+void VirtualMedium::pruneTransmissions() {
+	while (!transmissions.empty()
+			&& transmissions.front().endTime + TransmissionRetentionNanoseconds < _now) {
+		transmissions.pop_front();
+		firstTransmissionID++;
+	}
+}
+
+
+
+int VirtualMedium::receivedPowerDBm(const VirtualTransmission& aTransmission, unsigned int receiverIndex) const {
+	return aTransmission.txPowerDBm + linkModel(aTransmission.senderIndex, receiverIndex).pathGainDBm;
+}
+
+
+/*
+ * Only receivers listening on the frequency when the address completes at the sender are candidates.
+ * Each gets the address after its link delay, unless the link loses the packet or it is too weak.
+ */
+void VirtualMedium::deliverAddress(uint64_t transmissionID) {
+	const VirtualTransmission* aTransmission = transmission(transmissionID);
+	assert(aTransmission != nullptr);
+
+	for (auto& receiver : nodes) {
+		if (receiver->index() == aTransmission->senderIndex
+				|| receiver->state() != VirtualRadio::State::Rx
+				|| receiver->registers.FREQUENCY != aTransmission->frequency) {
+			continue;
+		}
+
+		const VirtualLink link = linkModel(aTransmission->senderIndex, receiver->index());
+		if (aTransmission->txPowerDBm + link.pathGainDBm < sensitivityDBm) {
+			continue;
+		}
+		if (link.lossProbability > 0 && random() < link.lossProbability) {
+			_statistics.lost++;
+			continue;
+		}
+		schedule(_now + link.delayNanoseconds, Action::ReceiveAddress, *receiver, 0, transmissionID);
+	}
+}
+
+
+int VirtualMedium::energyDBm(const VirtualRadio& receiver, uint32_t frequency) const {
+	int strongest = noiseFloorDBm;
+	for (const VirtualTransmission& aTransmission : transmissions) {
+		if (aTransmission.frequency == frequency
+				&& aTransmission.senderIndex != receiver.index()
+				&& aTransmission.startTime <= _now && _now < aTransmission.endTime) {
+			int power = receivedPowerDBm(aTransmission, receiver.index());
+			if (power > strongest) {
+				strongest = power;
+			}
+		}
+	}
+	return strongest;
+}
+
+
+bool VirtualMedium::isCollided(const VirtualTransmission& aTransmission, const VirtualRadio& receiver, int rssiDBm) const {
+	for (const VirtualTransmission& other : transmissions) {
+		if (other.id != aTransmission.id
+				&& other.frequency == aTransmission.frequency
+				&& other.senderIndex != receiver.index()
+				&& other.startTime < aTransmission.endTime
+				&& other.endTime > aTransmission.startTime
+				&& receivedPowerDBm(other, receiver.index()) >= rssiDBm - captureThresholdDB) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void VirtualMedium::countReception(bool isCRCValid, bool isCollided) {
+	_statistics.receptions++;
+	if (isCRCValid) {
+		_statistics.receivedCRCValid++;
+	}
+	else {
+		_statistics.receivedCRCInvalid++;
+	}
+	if (isCollided) {
+		_statistics.collisions++;
+	}
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <inttypes.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "virtualRadio.h"
+
+
+/*
+ * One direction of a link between two nodes.
+ */
+struct VirtualLink {
+	uint32_t delayNanoseconds;
+	// Chance that the receiver does not detect the packet at all (no ADDRESS)
+	float lossProbability;
+	// Received power for a sender at 0 dBm; the sender's TXPOWER adds to it
+	int pathGainDBm;
+};
+
+
+/*
+ * A packet on-air, as the sender's registers described it at START.
+ * Receivers compare their own configuration to it.
+ */
+struct VirtualTransmission {
+	uint64_t id;
+	unsigned int senderIndex;
+	uint32_t frequency;
+	uint32_t mode;
+	uint64_t addressKey;
+	uint32_t packetConfig0;
+	uint32_t packetConfig1;
+	uint32_t crcConfig;
+	uint32_t crcPoly;
+	uint32_t crcInit;
+	uint32_t whiteningSeed;
+	int txPowerDBm;
+	// RAM image: S0, LENGTH, S1, payload
+	std::vector<uint8_t> image;
+	uint32_t headerLength;
+
+	// Nanoseconds: START, ADDRESS event, END
+	uint64_t startTime;
+	uint64_t addressTime;
+	uint64_t endTime;
+	// Sender disabled or stopped before END
+	bool isAborted;
+};
+
+
+struct VirtualMediumStatistics {
+	uint64_t transmissions;
+	uint64_t aborted;
+	// Receivers that saw ADDRESS
+	uint64_t receptions;
+	uint64_t receivedCRCValid;
+	uint64_t receivedCRCInvalid;
+	// CRC invalid because another transmission overlapped at comparable power
+	uint64_t collisions;
+	// Receivers listening on the frequency that lost the packet on the link
+	uint64_t lost;
+	uint64_t events;
+};
+
+
+/*
+ * Shared RF medium: simulated time, nodes, and what is on-air.
+ *
+ * Single threaded discrete event simulation.
+ * Time is in nanoseconds from start, only advances between events.
+ *
+ * Owns the nodes (VirtualRadio), which keep their addresses for the life of the medium.
+ *
+ * Link model is per ordered pair of nodes: delay, loss, path gain (see VirtualLink.)
+ * Default is every node hears every other at -60 dBm, no delay, no loss.
+ *
+ * Collisions: a reception fails CRC if another transmission on the same frequency overlapped it
+ * and arrived no weaker than (received power - capture threshold.)
+ * Below the sensitivity a packet is not detected.
+ */
+class VirtualMedium {
+public:
+	static const int DefaultSensitivityDBm = -96;
+	static const int DefaultNoiseFloorDBm = -100;
+	static const int DefaultCaptureThresholdDB = 6;
+
+	typedef std::function<VirtualLink(unsigned int fromIndex, unsigned int toIndex)> LinkModel;
+
+	explicit VirtualMedium(uint32_t seed = 1);
+	VirtualMedium(const VirtualMedium&) = delete;
+	VirtualMedium& operator=(const VirtualMedium&) = delete;
+
+	/*
+	 * deviceID becomes the node's FICR DEVICEID.
+	 */
+	VirtualRadio& addNode(uint64_t deviceID);
+	unsigned int nodeCount() const { return nodes.size(); }
+	VirtualRadio& node(unsigned int index) { return *nodes[index]; }
+
+	void setLinkModel(LinkModel model);
+	void setCaptureThresholdDB(int value) { captureThresholdDB = value; }
+	void setNoiseFloorDBm(int value) { noiseFloorDBm = value; }
+	void setSensitivityDBm(int value) { sensitivityDBm = value; }
+
+	uint64_t now() const { return _now; }
+
+	/*
+	 * Run node code (e.g. an app timer) at a simulated time, with the node current.
+	 */
+	void callAt(uint64_t time, VirtualRadio& node, std::function<void()> call);
+
+	/*
+	 * Process the earliest pending event.
+	 * Returns false when none.
+	 */
+	bool runOne();
+	/*
+	 * Process events up to and including time, then set now to time.
+	 */
+	void runUntil(uint64_t time);
+
+	const VirtualMediumStatistics& statistics() const { return _statistics; }
+	/*
+	 * Uniform in [0, 1).  Seeded, so runs are reproducible.
+	 */
+	float random();
+
+
+	/*
+	 * Used by VirtualRadio.
+	 */
+	enum class Action { RampUpDone, TXDisableDone, TransmitAddressDone, TransmitEnd, ReceiveAddress, ReceiveEnd, BitCounterMatch, InterruptPending, Call };
+
+	void schedule(uint64_t time, Action action, VirtualRadio& node, uint32_t generation, uint64_t transmissionID);
+	uint64_t beginTransmission(VirtualTransmission& transmission);
+	void abortTransmission(uint64_t transmissionID);
+	// Null if too old
+	const VirtualTransmission* transmission(uint64_t transmissionID) const;
+	// Hand a transmission whose address is complete to listening receivers
+	void deliverAddress(uint64_t transmissionID);
+	// Received power of strongest transmission on-air now on the frequency, else noise floor
+	int energyDBm(const VirtualRadio& receiver, uint32_t frequency) const;
+	bool isCollided(const VirtualTransmission& transmission, const VirtualRadio& receiver, int rssiDBm) const;
+	void countReception(bool isCRCValid, bool isCollided);
+
+private:
+	struct ScheduledAction {
+		uint64_t time;
+		// Order among actions at the same time: first scheduled, first done
+		uint64_t sequence;
+		Action action;
+		VirtualRadio* node;
+		uint32_t generation;
+		uint64_t transmissionID;
+		std::function<void()> call;
+
+		bool operator>(const ScheduledAction& other) const {
+			return time != other.time ? time > other.time : sequence > other.sequence;
+		}
+	};
+
+	std::vector<std::unique_ptr<VirtualRadio>> nodes;
+	std::priority_queue<ScheduledAction, std::vector<ScheduledAction>, std::greater<ScheduledAction>> pending;
+	uint64_t sequence;
+	uint64_t _now;
+
+	// Transmissions in order of id, oldest pruned once no reception can refer to them
+	std::deque<VirtualTransmission> transmissions;
+	uint64_t firstTransmissionID;
+	uint64_t nextTransmissionID;
+
+	LinkModel linkModel;
+	int captureThresholdDB;
+	int noiseFloorDBm;
+	int sensitivityDBm;
+
+	uint32_t randomState;
+	VirtualMediumStatistics _statistics;
+
+	void dispatch(const ScheduledAction& scheduled);
+	void pruneTransmissions();
+	int receivedPowerDBm(const VirtualTransmission& transmission, unsigned int receiverIndex) const;
+};
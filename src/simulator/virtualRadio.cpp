@@ -0,0 +1,586 @@
+#include <cassert>
+#include <string.h>	// memcpy
+
+#include "virtualRadio.h"
+#include "virtualMedium.h"
+
+#include "radio/airtime.h"
+
+
+namespace {
+
+VirtualRadio* currentNode = nullptr;
+
+const uint64_t NanosecondsPerMicrosecond = 1000;
+
+uint64_t bitsToNanoseconds(uint32_t bits, uint32_t mode) {
+	return (uint64_t) bits * 1000000 / RadioModes::kilobitsPerSecond(RadioModes::modeOf(mode));
+}
+
+uint32_t field(uint32_t value, uint32_t mask, uint32_t position) {
+	return (value & mask) >> position;
+}
+
+/*
+ * Count of RAM bytes (S0, LENGTH, S1, payload) complete after bits on-air following the address.
+ */
+uint32_t bytesInBits(uint32_t pcnf0, uint32_t bits) {
+	const uint32_t fieldBits[] = {
+			8 * field(pcnf0, RADIO_PCNF0_S0LEN_Msk, RADIO_PCNF0_S0LEN_Pos),
+			field(pcnf0, RADIO_PCNF0_LFLEN_Msk, RADIO_PCNF0_LFLEN_Pos),
+			field(pcnf0, RADIO_PCNF0_S1LEN_Msk, RADIO_PCNF0_S1LEN_Pos) };
+	uint32_t result = 0;
+
+	for (uint32_t fieldBitCount : fieldBits) {
+		if (fieldBitCount == 0) continue;
+		if (bits < fieldBitCount) return result;
+		bits -= fieldBitCount;
+		result += (fieldBitCount + 7) / 8;
+	}
+	return result + bits / 8;
+}
+
+}  // namespace
+
+
+
+NRF_RADIO_Type* virtualRadioRegisters() {
+	assert(currentNode != nullptr);
+	return &currentNode->registers;
+}
+
+NRF_FICR_Type* virtualFICRRegisters() {
+	assert(currentNode != nullptr);
+	return &currentNode->ficr;
+}
+
+VirtualTaskRegister& VirtualTaskRegister::operator=(uint32_t value) {
+	if (value != 0) {
+		owner->trigger(task);
+	}
+	return *this;
+}
+
+VirtualPowerRegister& VirtualPowerRegister::operator=(uint32_t aValue) {
+	value = aValue & 1;
+	owner->writePower(value);
+	return *this;
+}
+
+
+
+VirtualRadio::Scope::Scope(VirtualRadio& node) : previous(currentNode) { currentNode = &node; }
+VirtualRadio::Scope::~Scope() { currentNode = previous; }
+
+VirtualRadio* VirtualRadio::current() { return currentNode; }
+
+
+
+VirtualRadio::VirtualRadio(VirtualMedium& medium, unsigned int index, uint64_t deviceID) :
+	_medium(medium),
+	_index(index),
+	_state(State::Disabled),
+	generation(0),
+	interruptHandler(),
+	isInterruptPosted(false),
+	interruptLatencyNanoseconds(0),
+	latchedBuffer(nullptr),
+	receivingID(0),
+	receivingRSSIDBm(0),
+	transmittingID(0),
+	bitCounterID(0)
+{
+	registers.TASKS_TXEN.bind(this, VirtualRadioTask::TXEN);
+	registers.TASKS_RXEN.bind(this, VirtualRadioTask::RXEN);
+	registers.TASKS_START.bind(this, VirtualRadioTask::START);
+	registers.TASKS_STOP.bind(this, VirtualRadioTask::STOP);
+	registers.TASKS_DISABLE.bind(this, VirtualRadioTask::DISABLE);
+	registers.TASKS_RSSISTART.bind(this, VirtualRadioTask::RSSISTART);
+	registers.TASKS_RSSISTOP.bind(this, VirtualRadioTask::RSSISTOP);
+	registers.TASKS_BCSTART.bind(this, VirtualRadioTask::BCSTART);
+	registers.TASKS_BCSTOP.bind(this, VirtualRadioTask::BCSTOP);
+	registers.INTENCLR.bind(&registers.INTENSET);
+	registers.POWER.bind(this);
+	resetRegisters();
+
+	ficr.DEVICEID[0] = (uint32_t) deviceID;
+	ficr.DEVICEID[1] = (uint32_t) (deviceID >> 32);
+	// Not what Nordic programs, but unique per node like it
+	ficr.DEVICEADDR[0] = (uint32_t) (deviceID * 0x9E3779B97F4A7C15ull >> 32);
+	ficr.DEVICEADDR[1] = (uint32_t) (deviceID * 0xC2B2AE3D27D4EB4Full >> 48);
+}
+
+
+void VirtualRadio::setInterruptHandler(std::function<void()> handler) { interruptHandler = handler; }
+void VirtualRadio::setInterruptLatencyNanoseconds(uint32_t value) { interruptLatencyNanoseconds = value; }
+
+
+/*
+ * Reset values per the product specification (nRF52832.)
+ */
+void VirtualRadio::resetRegisters() {
+	registers.EVENTS_READY = 0;
+	registers.EVENTS_ADDRESS = 0;
+	registers.EVENTS_PAYLOAD = 0;
+	registers.EVENTS_END = 0;
+	registers.EVENTS_DISABLED = 0;
+	registers.EVENTS_DEVMATCH = 0;
+	registers.EVENTS_DEVMISS = 0;
+	registers.EVENTS_RSSIEND = 0;
+	registers.EVENTS_BCMATCH = 0;
+	registers.EVENTS_CRCOK = 0;
+	registers.EVENTS_CRCERROR = 0;
+
+	registers.SHORTS = 0;
+	registers.INTENCLR = 0xFFFFFFFF;
+	registers.CRCSTATUS = 0;
+	registers.RXMATCH = 0;
+	registers.RXCRC = 0;
+	registers.DAI = 0;
+	registers.PACKETPTR = 0;
+	registers.FREQUENCY = 2;
+	registers.TXPOWER = 0;
+	registers.MODE = 0;
+	registers.PCNF0 = 0;
+	registers.PCNF1 = 0;
+	registers.BASE0 = 0;
+	registers.BASE1 = 0;
+	registers.PREFIX0 = 0;
+	registers.PREFIX1 = 0;
+	registers.TXADDRESS = 0;
+	registers.RXADDRESSES = 0;
+	registers.CRCCNF = 0;
+	registers.CRCPOLY = 0;
+	registers.CRCINIT = 0;
+	registers.TIFS = 0;
+	registers.RSSISAMPLE = 0;
+	registers.STATE = 0;
+	registers.DATAWHITEIV = 0x40;
+	registers.BCC = 0x10;
+	for (unsigned int i = 0; i < 8; i++) {
+		registers.DAB[i] = 0;
+		registers.DAP[i] = 0;
+	}
+	registers.DACNF = 0;
+	registers.MODECNF0 = 0x200;
+}
+
+
+void VirtualRadio::setState(State state) {
+	_state = state;
+	registers.STATE = static_cast<uint32_t>(state);
+}
+
+
+void VirtualRadio::raise(volatile uint32_t& event, uint32_t interruptMask) {
+	event = 1;
+	if ((registers.INTENSET & interruptMask) && !isInterruptPosted) {
+		isInterruptPosted = true;
+		_medium.schedule(_medium.now() + interruptLatencyNanoseconds,
+				VirtualMedium::Action::InterruptPending, *this, generation, 0);
+	}
+}
+
+void VirtualRadio::followShortcut(uint32_t shortcutMask, VirtualRadioTask task) {
+	if (registers.SHORTS & shortcutMask) {
+		trigger(task);
+	}
+}
+
+
+/*
+ * Interrupt line is the OR of enabled, set events.
+ * Handler is called once per posting: a handler that fails to clear its event is not re-entered forever.
+ */
+void VirtualRadio::onInterruptPending() {
+	isInterruptPosted = false;
+
+	uint32_t pendingMask = 0;
+	if (registers.EVENTS_READY) pendingMask |= RADIO_INTENSET_READY_Msk;
+	if (registers.EVENTS_ADDRESS) pendingMask |= RADIO_INTENSET_ADDRESS_Msk;
+	if (registers.EVENTS_PAYLOAD) pendingMask |= RADIO_INTENSET_PAYLOAD_Msk;
+	if (registers.EVENTS_END) pendingMask |= RADIO_INTENSET_END_Msk;
+	if (registers.EVENTS_DISABLED) pendingMask |= RADIO_INTENSET_DISABLED_Msk;
+	if (registers.EVENTS_RSSIEND) pendingMask |= RADIO_INTENSET_RSSIEND_Msk;
+	if (registers.EVENTS_BCMATCH) pendingMask |= RADIO_INTENSET_BCMATCH_Msk;
+	if (registers.EVENTS_CRCOK) pendingMask |= RADIO_INTENSET_CRCOK_Msk;
+	if (registers.EVENTS_CRCERROR) pendingMask |= RADIO_INTENSET_CRCERROR_Msk;
+
+	if ((pendingMask & registers.INTENSET) && interruptHandler) {
+		Scope scope(*this);
+		interruptHandler();
+	}
+}
+
+
+
+void VirtualRadio::writePower(uint32_t value) {
+	if (value == 0) {
+		if (transmittingID != 0) {
+			_medium.abortTransmission(transmittingID);
+		}
+		generation++;
+		transmittingID = 0;
+		receivingID = 0;
+		latchedBuffer = nullptr;
+		resetRegisters();
+		setState(State::Disabled);
+	}
+}
+
+
+void VirtualRadio::trigger(VirtualRadioTask task) {
+	if (registers.POWER == 0) {
+		return;
+	}
+
+	switch (task) {
+	case VirtualRadioTask::TXEN:
+		if (_state == State::Disabled) {
+			startRampUp(State::TxRu);
+		}
+		break;
+	case VirtualRadioTask::RXEN:
+		if (_state == State::Disabled) {
+			startRampUp(State::RxRu);
+		}
+		break;
+	case VirtualRadioTask::START:
+		if (_state == State::TxIdle || _state == State::RxIdle) {
+			startPacket();
+		}
+		break;
+	case VirtualRadioTask::STOP:
+		if (_state == State::Tx) {
+			_medium.abortTransmission(transmittingID);
+			transmittingID = 0;
+			generation++;
+			setState(State::TxIdle);
+		}
+		else if (_state == State::Rx) {
+			receivingID = 0;
+			generation++;
+			setState(State::RxIdle);
+		}
+		break;
+	case VirtualRadioTask::DISABLE:
+		disable();
+		break;
+	case VirtualRadioTask::RSSISTART:
+		sampleRSSI();
+		break;
+	case VirtualRadioTask::BCSTART:
+		startBitCounter();
+		break;
+	case VirtualRadioTask::BCSTOP:
+		bitCounterID = 0;
+		break;
+	case VirtualRadioTask::RSSISTOP:
+		// Not modeled
+		break;
+	}
+}
+
+
+void VirtualRadio::startRampUp(State rampState) {
+	setState(rampState);
+	uint64_t rampUp = RadioModes::rampUpMicroseconds(RadioModes::modeOf(registers.MODE),
+			RadioAirtime::isFastRampUp(registers.MODECNF0));
+	_medium.schedule(_medium.now() + rampUp * NanosecondsPerMicrosecond,
+			VirtualMedium::Action::RampUpDone, *this, generation, 0);
+}
+
+void VirtualRadio::onRampUpDone(uint32_t aGeneration) {
+	if (aGeneration != generation) return;
+
+	setState(_state == State::TxRu ? State::TxIdle : State::RxIdle);
+	raise(registers.EVENTS_READY, RADIO_INTENSET_READY_Msk);
+	followShortcut(RADIO_SHORTS_READY_START_Msk, VirtualRadioTask::START);
+}
+
+
+/*
+ * START latches PACKETPTR.
+ * In TX the packet is read from RAM now: later writes to the buffer do not go on-air.
+ */
+void VirtualRadio::startPacket() {
+	if (_state == State::RxIdle) {
+		setState(State::Rx);
+		latchedBuffer = reinterpret_cast<uint8_t*>((uintptr_t) registers.PACKETPTR);
+		receivingID = 0;
+		return;
+	}
+
+	assert(_state == State::TxIdle);
+	setState(State::Tx);
+
+	const uint32_t pcnf0 = registers.PCNF0;
+	const uint32_t pcnf1 = registers.PCNF1;
+	const uint32_t s0Bytes = field(pcnf0, RADIO_PCNF0_S0LEN_Msk, RADIO_PCNF0_S0LEN_Pos);
+	const uint32_t lengthBits = field(pcnf0, RADIO_PCNF0_LFLEN_Msk, RADIO_PCNF0_LFLEN_Pos);
+	const uint32_t s1Bits = field(pcnf0, RADIO_PCNF0_S1LEN_Msk, RADIO_PCNF0_S1LEN_Pos);
+	const uint32_t maxLength = field(pcnf1, RADIO_PCNF1_MAXLEN_Msk, RADIO_PCNF1_MAXLEN_Pos);
+
+	const uint8_t* buffer = reinterpret_cast<const uint8_t*>((uintptr_t) registers.PACKETPTR);
+	assert(buffer != nullptr);
+
+	VirtualTransmission transmission;
+	transmission.senderIndex = _index;
+	transmission.frequency = registers.FREQUENCY;
+	transmission.mode = registers.MODE;
+	transmission.addressKey = logicalAddressKey((uint8_t) (registers.TXADDRESS & 7));
+	transmission.packetConfig0 = pcnf0;
+	transmission.packetConfig1 = pcnf1 & ~RADIO_PCNF1_MAXLEN_Msk;
+	transmission.crcConfig = registers.CRCCNF;
+	transmission.crcPoly = registers.CRCPOLY;
+	transmission.crcInit = registers.CRCINIT;
+	transmission.whiteningSeed = (pcnf1 & RADIO_PCNF1_WHITEEN_Msk) ? (registers.DATAWHITEIV & RADIO_DATAWHITEIV_DATAWHITEIV_Msk) : 0;
+	transmission.txPowerDBm = static_cast<int8_t>(registers.TXPOWER);
+
+	transmission.headerLength = s0Bytes + (lengthBits > 0 ? 1 : 0) + (s1Bits > 0 ? 1 : 0);
+	uint32_t lengthField = lengthBits > 0 ? (buffer[s0Bytes] & ((1u << lengthBits) - 1)) : 0;
+	uint32_t payloadLength = lengthField + RadioAirtime::staticLength(pcnf1);
+	if (payloadLength > maxLength) {
+		payloadLength = maxLength;
+	}
+	transmission.image.assign(buffer, buffer + transmission.headerLength + payloadLength);
+
+	const uint32_t syncBits = RadioAirtime::preambleBits(pcnf0) + RadioAirtime::addressBits(pcnf1);
+	const uint32_t packetBits = syncBits
+			+ RadioAirtime::headerBits(pcnf0)
+			+ 8 * payloadLength
+			+ RadioAirtime::crcBits(transmission.crcConfig);
+	transmission.startTime = _medium.now();
+	transmission.addressTime = transmission.startTime + bitsToNanoseconds(syncBits, transmission.mode);
+	transmission.endTime = transmission.startTime + bitsToNanoseconds(packetBits, transmission.mode);
+	transmission.isAborted = false;
+
+	transmittingID = _medium.beginTransmission(transmission);
+	_medium.schedule(transmission.addressTime, VirtualMedium::Action::TransmitAddressDone, *this, generation, transmittingID);
+	_medium.schedule(transmission.endTime, VirtualMedium::Action::TransmitEnd, *this, generation, transmittingID);
+}
+
+
+void VirtualRadio::onTransmitAddressDone(uint32_t aGeneration, uint64_t transmissionID) {
+	if (aGeneration != generation) return;
+
+	raise(registers.EVENTS_ADDRESS, RADIO_INTENSET_ADDRESS_Msk);
+	followShortcut(RADIO_SHORTS_ADDRESS_BCSTART_Msk, VirtualRadioTask::BCSTART);
+	_medium.deliverAddress(transmissionID);
+}
+
+void VirtualRadio::onTransmitEnd(uint32_t aGeneration, uint64_t transmissionID) {
+	if (aGeneration != generation) return;
+	assert(transmissionID == transmittingID);
+	(void) transmissionID;
+
+	transmittingID = 0;
+	bitCounterID = 0;
+	setState(State::TxIdle);
+	raise(registers.EVENTS_PAYLOAD, RADIO_INTENSET_PAYLOAD_Msk);
+	raise(registers.EVENTS_END, RADIO_INTENSET_END_Msk);
+	followShortcut(RADIO_SHORTS_END_DISABLE_Msk, VirtualRadioTask::DISABLE);
+	followShortcut(RADIO_SHORTS_END_START_Msk, VirtualRadioTask::START);
+}
+
+
+void VirtualRadio::onReceiveAddress(const VirtualTransmission& transmission, int rssiDBm) {
+	if (_state != State::Rx || receivingID != 0
+			|| registers.FREQUENCY != transmission.frequency
+			|| registers.MODE != transmission.mode) {
+		return;
+	}
+
+	uint8_t logicalAddress;
+	for (logicalAddress = 0; logicalAddress < 8; logicalAddress++) {
+		if ((registers.RXADDRESSES & (1u << logicalAddress))
+				&& logicalAddressKey(logicalAddress) == transmission.addressKey) {
+			break;
+		}
+	}
+	if (logicalAddress == 8) {
+		return;
+	}
+
+	receivingID = transmission.id;
+	receivingRSSIDBm = rssiDBm;
+	registers.RXMATCH = logicalAddress;
+	raise(registers.EVENTS_ADDRESS, RADIO_INTENSET_ADDRESS_Msk);
+	followShortcut(RADIO_SHORTS_ADDRESS_RSSISTART_Msk, VirtualRadioTask::RSSISTART);
+	followShortcut(RADIO_SHORTS_ADDRESS_BCSTART_Msk, VirtualRadioTask::BCSTART);
+
+	// Propagation delay already elapsed: END is as far after ADDRESS as at the sender
+	_medium.schedule(_medium.now() + (transmission.endTime - transmission.addressTime),
+			VirtualMedium::Action::ReceiveEnd, *this, generation, transmission.id);
+}
+
+
+/*
+ * Packet is written to the buffer latched at START, truncated to what MAXLEN allows.
+ * CRC fails for: sender aborted, formats differ, collision, or payload longer than MAXLEN.
+ */
+void VirtualRadio::onReceiveEnd(uint32_t aGeneration, uint64_t transmissionID) {
+	if (aGeneration != generation || transmissionID != receivingID) return;
+
+	const VirtualTransmission* transmission = _medium.transmission(transmissionID);
+	assert(transmission != nullptr);
+
+	const bool isCollided = _medium.isCollided(*transmission, *this, receivingRSSIDBm);
+	const bool isCRCValid = !transmission->isAborted && isFormatCompatible(*transmission) && !isCollided;
+
+	const uint32_t capacity = transmission->headerLength
+			+ field(registers.PCNF1, RADIO_PCNF1_MAXLEN_Msk, RADIO_PCNF1_MAXLEN_Pos);
+	const uint32_t length = transmission->image.size() < capacity ? transmission->image.size() : capacity;
+	if (latchedBuffer != nullptr && length > 0) {
+		memcpy(latchedBuffer, transmission->image.data(), length);
+	}
+
+	_medium.countReception(isCRCValid, isCollided);
+
+	receivingID = 0;
+	bitCounterID = 0;
+	registers.CRCSTATUS = isCRCValid ? 1 : 0;
+	setState(State::RxIdle);
+	raise(registers.EVENTS_PAYLOAD, RADIO_INTENSET_PAYLOAD_Msk);
+	raise(registers.EVENTS_END, RADIO_INTENSET_END_Msk);
+	if (isCRCValid) {
+		raise(registers.EVENTS_CRCOK, RADIO_INTENSET_CRCOK_Msk);
+	}
+	else {
+		raise(registers.EVENTS_CRCERROR, RADIO_INTENSET_CRCERROR_Msk);
+	}
+	followShortcut(RADIO_SHORTS_END_DISABLE_Msk, VirtualRadioTask::DISABLE);
+	followShortcut(RADIO_SHORTS_END_START_Msk, VirtualRadioTask::START);
+}
+
+
+/*
+ * From RX: DISABLED at once (RXDISABLE takes no time.)
+ * From TX: through TXDISABLE; a packet in progress is cut off.
+ */
+void VirtualRadio::disable() {
+	if (_state == State::Disabled) {
+		return;
+	}
+	generation++;
+
+	switch (_state) {
+	case State::TxRu:
+	case State::TxIdle:
+	case State::Tx:
+	case State::TxDisable:
+		if (transmittingID != 0) {
+			_medium.abortTransmission(transmittingID);
+			transmittingID = 0;
+		}
+		setState(State::TxDisable);
+		_medium.schedule(_medium.now()
+					+ RadioModes::txDisableMicroseconds(RadioModes::modeOf(registers.MODE)) * NanosecondsPerMicrosecond,
+				VirtualMedium::Action::TXDisableDone, *this, generation, 0);
+		break;
+
+	default:
+		receivingID = 0;
+		latchedBuffer = nullptr;
+		// Same as TX disable done
+		onTXDisableDone(generation);
+	}
+}
+
+void VirtualRadio::onTXDisableDone(uint32_t aGeneration) {
+	if (aGeneration != generation) return;
+
+	setState(State::Disabled);
+	raise(registers.EVENTS_DISABLED, RADIO_INTENSET_DISABLED_Msk);
+	followShortcut(RADIO_SHORTS_DISABLED_TXEN_Msk, VirtualRadioTask::TXEN);
+	followShortcut(RADIO_SHORTS_DISABLED_RXEN_Msk, VirtualRadioTask::RXEN);
+}
+
+
+/*
+ * RSSISAMPLE is the magnitude of the (negative) dBm.
+ * As the datasheet: a sample is valid only in RX, after START.
+ * In RXIDLE the sample completes but RSSISAMPLE is left stale, as it is not valid on hardware.
+ */
+void VirtualRadio::sampleRSSI() {
+	if (_state == State::RxIdle) {
+		raise(registers.EVENTS_RSSIEND, RADIO_INTENSET_RSSIEND_Msk);
+		return;
+	}
+	if (_state != State::Rx) {
+		return;
+	}
+	int dBm = _medium.energyDBm(*this, registers.FREQUENCY);
+	int sample = -dBm;
+	if (sample < 0) sample = 0;
+	if (sample > 127) sample = 127;
+	registers.RSSISAMPLE = sample;
+	raise(registers.EVENTS_RSSIEND, RADIO_INTENSET_RSSIEND_Msk);
+}
+
+
+
+/*
+ * Counts from now, which is ADDRESS when started by shortcut.
+ * The packet's generation guards it: DISABLE or STOP before the match cancels it.
+ */
+void VirtualRadio::startBitCounter() {
+	bitCounterID = _state == State::Rx ? receivingID : (_state == State::Tx ? transmittingID : 0);
+	if (bitCounterID == 0) {
+		return;
+	}
+	_medium.schedule(_medium.now() + bitsToNanoseconds(registers.BCC, registers.MODE),
+			VirtualMedium::Action::BitCounterMatch, *this, generation, bitCounterID);
+}
+
+void VirtualRadio::onBitCounterMatch(uint32_t aGeneration, uint64_t transmissionID) {
+	if (aGeneration != generation || transmissionID != bitCounterID) return;
+
+	if (_state == State::Rx && latchedBuffer != nullptr) {
+		const VirtualTransmission* transmission = _medium.transmission(transmissionID);
+		assert(transmission != nullptr);
+		uint32_t length = bytesInBits(registers.PCNF0, registers.BCC);
+		if (length > transmission->image.size()) {
+			length = transmission->image.size();
+		}
+		memcpy(latchedBuffer, transmission->image.data(), length);
+	}
+	raise(registers.EVENTS_BCMATCH, RADIO_INTENSET_BCMATCH_Msk);
+}
+
+
+/*
+ * BALEN bytes of base (the most significant bytes, as the radio uses), and the prefix byte.
+ */
+uint64_t VirtualRadio::logicalAddressKey(uint8_t logicalAddress) const {
+	assert(logicalAddress < 8);
+
+	const uint32_t baseLength = field(registers.PCNF1, RADIO_PCNF1_BALEN_Msk, RADIO_PCNF1_BALEN_Pos);
+	uint32_t base = logicalAddress == 0 ? registers.BASE0 : registers.BASE1;
+	if (baseLength == 0) {
+		base = 0;
+	}
+	else if (baseLength < 4) {
+		base &= 0xFFFFFFFFu << (8 * (4 - baseLength));
+	}
+
+	const uint32_t prefixes = logicalAddress < 4 ? registers.PREFIX0 : registers.PREFIX1;
+	const uint32_t prefix = (prefixes >> (8 * (logicalAddress % 4))) & 0xFF;
+
+	return ((uint64_t) baseLength << 40) | ((uint64_t) base << 8) | prefix;
+}
+
+
+bool VirtualRadio::isFormatCompatible(const VirtualTransmission& transmission) const {
+	const uint32_t pcnf1 = registers.PCNF1;
+	const uint32_t crcConfig = registers.CRCCNF;
+	const uint32_t whiteningSeed = (pcnf1 & RADIO_PCNF1_WHITEEN_Msk) ? (registers.DATAWHITEIV & RADIO_DATAWHITEIV_DATAWHITEIV_Msk) : 0;
+	const bool isCRC = (crcConfig & RADIO_CRCCNF_LEN_Msk) != 0;
+
+	return registers.PCNF0 == transmission.packetConfig0
+			&& (pcnf1 & ~RADIO_PCNF1_MAXLEN_Msk) == transmission.packetConfig1
+			&& crcConfig == transmission.crcConfig
+			&& (!isCRC || (registers.CRCPOLY == transmission.crcPoly && registers.CRCINIT == transmission.crcInit))
+			&& whiteningSeed == transmission.whiteningSeed
+			&& transmission.image.size() - transmission.headerLength <= field(pcnf1, RADIO_PCNF1_MAXLEN_Msk, RADIO_PCNF1_MAXLEN_Pos);
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <inttypes.h>
+#include <functional>
+
+#include "nrf.h"
+
+
+class VirtualMedium;
+struct VirtualTransmission;
+
+
+/*
+ * One simulated node's RADIO peripheral.
+ *
+ * Owns a register block (what NRF_RADIO designates while the node is current)
+ * and runs the radio's state machine against the node's VirtualMedium:
+ *
+ *   DISABLED -TXEN-> TXRU -(ramp up)-> TXIDLE -START-> TX -(packet time)-> TXIDLE
+ *   DISABLED -RXEN-> RXRU -(ramp up)-> RXIDLE -START-> RX (listening, then receiving after ADDRESS) -> RXIDLE
+ *   any -DISABLE-> DISABLED (immediately from RX, after TXDISABLE from TX)
+ *
+ * Events are set in the EVENTS_x registers, shortcuts (SHORTS) are followed as the hardware does,
+ * and the node's interrupt handler is called (asynchronously, from the medium) when an enabled event is set.
+ *
+ * What is decoded from registers:
+ * - FREQUENCY, MODE: sender and receiver must agree
+ * - TXADDRESS, RXADDRESSES, BASEn, PREFIXn, BALEN: address match, RXMATCH
+ * - PCNF0, PCNF1: RAM layout and on-air time; STATLEN, LENGTH field, MAXLEN
+ * - CRCCNF, CRCPOLY, CRCINIT, WHITEEN, DATAWHITEIV: a receiver configured differently gets CRCSTATUS 0
+ * - MODECNF0: ramp up time
+ * - TXPOWER: added to the link's path gain
+ *
+ * Bit counter: BCMATCH at BCC bits after ADDRESS (BCSTART); in RX, the packet bytes counted so far are in RAM then.
+ *
+ * RSSI sampling completes at once (RSSIEND is set on RSSISTART) so driver code spinning on it does not hang.
+ * Only a sample in RX (after START) updates RSSISAMPLE: in RXIDLE it stays stale, as its value is not valid on hardware.
+ * Driver code spinning on any other event hangs the simulation: simulated time does not pass during node code.
+ */
+class VirtualRadio {
+public:
+	enum class State : uint32_t {
+		Disabled = RADIO_STATE_STATE_Disabled,
+		RxRu = RADIO_STATE_STATE_RxRu,
+		RxIdle = RADIO_STATE_STATE_RxIdle,
+		Rx = RADIO_STATE_STATE_Rx,
+		TxRu = RADIO_STATE_STATE_TxRu,
+		TxIdle = RADIO_STATE_STATE_TxIdle,
+		Tx = RADIO_STATE_STATE_Tx,
+		TxDisable = RADIO_STATE_STATE_TxDisable
+	};
+
+	/*
+	 * While in scope, NRF_RADIO and NRF_FICR designate this node's registers.
+	 * Nests: restores the previously current node.
+	 */
+	class Scope {
+		VirtualRadio* previous;
+	public:
+		explicit Scope(VirtualRadio& node);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	static VirtualRadio* current();
+
+
+	VirtualRadio(VirtualMedium& medium, unsigned int index, uint64_t deviceID);
+	VirtualRadio(const VirtualRadio&) = delete;
+	VirtualRadio& operator=(const VirtualRadio&) = delete;
+
+	unsigned int index() const { return _index; }
+	VirtualMedium& medium() const { return _medium; }
+
+	NRF_RADIO_Type registers;
+	NRF_FICR_Type ficr;
+
+	/*
+	 * The node's RADIO_IRQHandler.
+	 * Called with this node current.
+	 */
+	void setInterruptHandler(std::function<void()> handler);
+	/*
+	 * Delay from an enabled event to the handler (default zero.)
+	 * Events set meanwhile are all pending when the handler runs, as with a late ISR.
+	 */
+	void setInterruptLatencyNanoseconds(uint32_t value);
+
+	State state() const { return _state; }
+
+	/*
+	 * Called by registers of this node.
+	 */
+	void trigger(VirtualRadioTask task);
+	void writePower(uint32_t value);
+
+	/*
+	 * Called by the medium when a scheduled change of this node is due.
+	 * generation is that of the node when the change was scheduled:
+	 * a DISABLE or power cycle in between makes it stale and it is ignored.
+	 */
+	void onRampUpDone(uint32_t generation);
+	void onTXDisableDone(uint32_t generation);
+	void onTransmitAddressDone(uint32_t generation, uint64_t transmissionID);
+	void onTransmitEnd(uint32_t generation, uint64_t transmissionID);
+	void onReceiveAddress(const VirtualTransmission& transmission, int rssiDBm);
+	void onReceiveEnd(uint32_t generation, uint64_t transmissionID);
+	void onBitCounterMatch(uint32_t generation, uint64_t transmissionID);
+	void onInterruptPending();
+
+	/*
+	 * The node's view of its on-air format, as the medium compares sender to receiver.
+	 */
+	uint64_t logicalAddressKey(uint8_t logicalAddress) const;
+	bool isFormatCompatible(const VirtualTransmission& transmission) const;
+
+private:
+	VirtualMedium& _medium;
+	const unsigned int _index;
+	State _state;
+	// Incremented on DISABLE and power off: invalidates pending scheduled changes
+	uint32_t generation;
+	std::function<void()> interruptHandler;
+	bool isInterruptPosted;
+	uint32_t interruptLatencyNanoseconds;
+
+	// While in RX: PACKETPTR latched on START, and packet being received (zero when none)
+	uint8_t* latchedBuffer;
+	uint64_t receivingID;
+	int receivingRSSIDBm;
+	// While in TX
+	uint64_t transmittingID;
+	// Packet (RX or TX) the bit counter is counting, zero when stopped
+	uint64_t bitCounterID;
+
+	void resetRegisters();
+	void setState(State state);
+	void raise(volatile uint32_t& event, uint32_t interruptMask);
+	void followShortcut(uint32_t shortcutMask, VirtualRadioTask task);
+
+	void startRampUp(State rampState);
+	void startPacket();
+	void disable();
+	void sampleRSSI();
+	void startBitCounter();
+};